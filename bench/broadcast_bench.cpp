@@ -0,0 +1,112 @@
+// Broadcast send-path benchmark: CPU per tick for plain sendto(), batched
+// sendmmsg(), UDP GSO and io_uring SENDMSG on loopback.
+//
+// Usage: broadcast_bench [--clients N] [--ticks T] [--payload BYTES] [--segments S]
+//
+// Every tick sends S datagrams of BYTES to each of N destinations. The
+// destinations are spread over a few loopback sink sockets that are never
+// read, so receive-side cost stays roughly constant across modes.
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <ctime>
+#include <unistd.h>
+#include <arpa/inet.h>
+
+#include "../server/batch_sender.h"
+
+constexpr int SINK_SOCKETS = 16;
+
+static double threadCpuMs() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+static double wallMs() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+int main(int argc, char** argv) {
+    int clients = 1000;
+    int ticks = 50;
+    size_t payload = 1200;
+    size_t segments = 1;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "--clients") clients = std::stoi(argv[i + 1]);
+        else if (arg == "--ticks") ticks = std::stoi(argv[i + 1]);
+        else if (arg == "--payload") payload = std::stoul(argv[i + 1]);
+        else if (arg == "--segments") segments = std::stoul(argv[i + 1]);
+        else {
+            std::cerr << "Unknown option " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<int> sinks;
+    std::vector<sockaddr_in> sinkAddrs;
+    for (int i = 0; i < SINK_SOCKETS; ++i) {
+        int fd = socket(AF_INET, SOCK_DGRAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+        bind(fd, (sockaddr*)&addr, sizeof(addr));
+        socklen_t len = sizeof(addr);
+        getsockname(fd, (sockaddr*)&addr, &len);
+        sinks.push_back(fd);
+        sinkAddrs.push_back(addr);
+    }
+
+    int sockfd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+    int sndbuf = 4 * 1024 * 1024;
+    setsockopt(sockfd, SOL_SOCKET, SO_SNDBUF, &sndbuf, sizeof(sndbuf));
+
+    std::vector<char> data(payload * segments, 'x');
+
+    std::cout << "clients=" << clients << " ticks=" << ticks << " payload=" << payload
+              << " segments/client=" << segments << std::endl;
+    std::cout << std::left << std::setw(8) << "mode" << std::right
+              << std::setw(14) << "cpu ms/tick" << std::setw(14) << "wall ms/tick"
+              << std::setw(14) << "syscalls/tick" << std::setw(14) << "sent/tick"
+              << std::setw(10) << "dropped" << std::endl;
+
+    for (SendMode requested : {SendMode::Plain, SendMode::Batched, SendMode::Gso, SendMode::Uring}) {
+        BatchSender sender(static_cast<size_t>(clients) * segments);
+        SendMode mode = sender.setMode(requested, sockfd);
+        if (mode != requested) {
+            std::cout << std::left << std::setw(8) << sendModeName(requested) << "unavailable" << std::endl;
+            continue;
+        }
+
+        double cpu0 = threadCpuMs();
+        double wall0 = wallMs();
+        for (int t = 0; t < ticks; ++t) {
+            sender.beginTick();
+            for (int c = 0; c < clients; ++c) {
+                sender.queueSegmented(sinkAddrs[c % SINK_SOCKETS], data.data(), data.size(), payload);
+            }
+            sender.flush(sockfd);
+        }
+        sender.beginTick();
+        double cpu = (threadCpuMs() - cpu0) / ticks;
+        double wall = (wallMs() - wall0) / ticks;
+        const SendStats& total = sender.getTotalStats();
+
+        std::cout << std::left << std::setw(8) << sendModeName(sender.getMode()) << std::right
+                  << std::fixed << std::setprecision(3)
+                  << std::setw(14) << cpu << std::setw(14) << wall
+                  << std::setw(14) << std::setprecision(1) << double(total.syscalls) / ticks
+                  << std::setw(14) << double(total.datagrams) / ticks
+                  << std::setw(10) << total.dropped << std::endl;
+    }
+
+    for (int fd : sinks) close(fd);
+    close(sockfd);
+    return 0;
+}
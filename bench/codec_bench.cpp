@@ -0,0 +1,214 @@
+// Snapshot codec benchmark: encodes the same player list as protobuf Player
+// messages and as a PLAYER_CODEC_PACKED block, and checks that both decode
+// back to the input.
+//
+// Usage: codec_bench [--players N] [--iterations I] [--spread S] [--blocked-pct P]
+//
+// Players get first-generation slot-map IDs and positions uniform in
+// [0, S]; P percent of them are blocked. Sizes are per snapshot (one block,
+// before MTU splitting); times are per encode and per decode. The run fails
+// if either codec does not round-trip exactly.
+//
+// Before the timed runs, the packed codec is also round-tripped on fixed
+// edge cases (negative coordinates, IDs of later generations, the full
+// int32 range, an empty block), every truncation of those blocks must be
+// rejected, and so must a few malformed headers. Any failure is reported
+// and makes the run fail.
+
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#include "../common/player_codec.h"
+#include "../generated/game.pb.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static bool sameRecord(const PlayerRecord& a, const PlayerRecord& b) {
+    return a.id == b.id && a.x == b.x && a.y == b.y && a.blocked == b.blocked;
+}
+
+// Encodes `players` as one packed block, checks that it decodes back
+// exactly and that every shorter prefix of it is rejected.
+static bool packedRoundTrip(const std::vector<PlayerRecord>& players) {
+    PackedBoundsBuilder builder;
+    for (const PlayerRecord& r : players) builder.add(r.id, r.x, r.y);
+    PackedPlayerEncoder encoder;
+    std::string block;
+    encoder.begin(block, builder.bounds(), static_cast<uint32_t>(players.size()));
+    for (const PlayerRecord& r : players) encoder.add(r.id, r.x, r.y, r.blocked);
+    encoder.finish();
+
+    std::vector<PlayerRecord> decoded;
+    if (!decodePackedPlayers(block.data(), block.size(), decoded) || decoded.size() != players.size()) return false;
+    for (size_t i = 0; i < players.size(); ++i) {
+        if (!sameRecord(decoded[i], players[i])) return false;
+    }
+    for (size_t len = 0; len < block.size(); ++len) {
+        decoded.clear();
+        if (decodePackedPlayers(block.data(), len, decoded)) return false;
+    }
+    return true;
+}
+
+// Runs the fixed edge cases; prints and counts the ones that fail.
+static int checkEdgeCases() {
+    const int32_t extremes[] = {INT32_MIN, INT32_MIN + 1, -1, 0, 1, INT32_MAX - 1, INT32_MAX};
+    std::vector<PlayerRecord> negative, generations, full_range;
+    for (int i = 0; i < 40; ++i) {
+        negative.push_back({static_cast<int32_t>((1u << 16) | i), -5000 + 97 * i, -3 * i, i % 2 == 0});
+        // Slot i with generations 0 to 0x7FFF, as slot-map handles are on the wire.
+        generations.push_back({static_cast<int32_t>((uint32_t(i * 0x7FFF / 39) << 16) | i), i, i, i % 3 == 0});
+    }
+    int k = 0;
+    for (int32_t x : extremes) {
+        for (int32_t y : extremes) {
+            full_range.push_back({k % 2 ? INT32_MAX - k : k, x, y, k % 2 == 0});
+            k++;
+        }
+    }
+    const std::vector<PlayerRecord> single_max = {{INT32_MAX, INT32_MIN, INT32_MAX, true}};
+
+    struct Case {
+        const char* name;
+        bool ok;
+    };
+    const Case cases[] = {
+        {"negative coordinates", packedRoundTrip(negative)},
+        {"mixed generations", packedRoundTrip(generations)},
+        {"full int32 range", packedRoundTrip(full_range)},
+        {"single extreme player", packedRoundTrip(single_max)},
+        {"empty block", packedRoundTrip({})},
+    };
+
+    // Malformed blocks: each must be rejected without reading past its end.
+    const std::string malformed[] = {
+        std::string("\x01\x00\x00\x00\x21\x00\x00\x00\x00\x00\x00\x00\x00", 13),  // 33-bit id field
+        std::string("\xff\xff\xff\xff\xff\xff", 6),                                      // Overlong varint
+        std::string("\xff\xff\xff\xff\x0f\x00\x00\x00\x20\x20\x20\x00\x00", 13),  // 2^32-1 players, 13 bytes
+        std::string("\x02\x00\x00\x00\x08\x08", 6),                                      // Header cut short
+    };
+    int failures = 0;
+    for (const Case& c : cases) {
+        if (c.ok) continue;
+        std::cout << "edge case MISMATCH: " << c.name << "\n";
+        failures++;
+    }
+    std::vector<PlayerRecord> decoded;
+    for (size_t m = 0; m < sizeof(malformed) / sizeof(malformed[0]); ++m) {
+        decoded.clear();
+        if (!decodePackedPlayers(malformed[m].data(), malformed[m].size(), decoded)) continue;
+        std::cout << "edge case MISMATCH: malformed block " << m << " accepted\n";
+        failures++;
+    }
+    std::cout << "edge cases: " << sizeof(cases) / sizeof(cases[0]) << " round trips, "
+              << sizeof(malformed) / sizeof(malformed[0]) << " malformed blocks, " << failures << " failed\n";
+    return failures;
+}
+
+int main(int argc, char** argv) {
+    size_t players = 10000;
+    int iterations = 200;
+    int spread = 10000;
+    int blocked_pct = 10;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "--players") players = std::stoul(argv[i + 1]);
+        else if (arg == "--iterations") iterations = std::stoi(argv[i + 1]);
+        else if (arg == "--spread") spread = std::stoi(argv[i + 1]);
+        else if (arg == "--blocked-pct") blocked_pct = std::stoi(argv[i + 1]);
+        else {
+            std::cerr << "Unknown option " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    const int edge_failures = checkEdgeCases();
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int32_t> coord(0, spread);
+    std::uniform_int_distribution<int> pct(0, 99);
+    std::vector<PlayerRecord> input(players);
+    for (size_t i = 0; i < players; ++i) {
+        input[i].id = static_cast<int32_t>((1u << 16) | i);  // Slot i, generation 1
+        input[i].x = coord(rng);
+        input[i].y = coord(rng);
+        input[i].blocked = pct(rng) < blocked_pct;
+    }
+
+    // --- protobuf: reused StatePacket, as SnapshotBroadcaster does ---
+    StatePacket sp;
+    std::string proto_out;
+    auto t0 = Clock::now();
+    for (int it = 0; it < iterations; ++it) {
+        sp.mutable_players()->Clear();
+        for (const PlayerRecord& r : input) {
+            Player* p = sp.add_players();
+            p->set_id(r.id);
+            p->set_x(r.x);
+            p->set_y(r.y);
+            p->set_blocked(r.blocked);
+        }
+        sp.SerializeToString(&proto_out);
+    }
+    double proto_encode_ms = msSince(t0) / iterations;
+
+    StatePacket parsed;
+    t0 = Clock::now();
+    for (int it = 0; it < iterations; ++it) parsed.ParseFromString(proto_out);
+    double proto_decode_ms = msSince(t0) / iterations;
+
+    bool proto_ok = static_cast<size_t>(parsed.players_size()) == players;
+    for (size_t i = 0; proto_ok && i < players; ++i) {
+        const Player& p = parsed.players(static_cast<int>(i));
+        proto_ok = sameRecord({p.id(), p.x(), p.y(), p.blocked()}, input[i]);
+    }
+
+    // --- packed ---
+    PackedPlayerEncoder encoder;
+    std::string packed_out;
+    t0 = Clock::now();
+    for (int it = 0; it < iterations; ++it) {
+        PackedBoundsBuilder builder;
+        for (const PlayerRecord& r : input) builder.add(r.id, r.x, r.y);
+        encoder.begin(packed_out, builder.bounds(), static_cast<uint32_t>(players));
+        for (const PlayerRecord& r : input) encoder.add(r.id, r.x, r.y, r.blocked);
+        encoder.finish();
+    }
+    double packed_encode_ms = msSince(t0) / iterations;
+
+    std::vector<PlayerRecord> decoded;
+    bool packed_ok = true;
+    t0 = Clock::now();
+    for (int it = 0; it < iterations; ++it) {
+        decoded.clear();
+        packed_ok &= decodePackedPlayers(packed_out.data(), packed_out.size(), decoded);
+    }
+    double packed_decode_ms = msSince(t0) / iterations;
+
+    packed_ok = packed_ok && decoded.size() == players;
+    for (size_t i = 0; packed_ok && i < players; ++i) packed_ok = sameRecord(decoded[i], input[i]);
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "players=" << players << " iterations=" << iterations << " spread=" << spread
+              << " blocked_pct=" << blocked_pct << "\n"
+              << "protobuf  " << proto_out.size() << " B (" << double(proto_out.size()) / players << " B/player)  "
+              << "encode " << proto_encode_ms << " ms  decode " << proto_decode_ms << " ms"
+              << (proto_ok ? "" : "  MISMATCH") << "\n"
+              << "packed    " << packed_out.size() << " B (" << double(packed_out.size()) / players << " B/player)  "
+              << "encode " << packed_encode_ms << " ms  decode " << packed_decode_ms << " ms"
+              << (packed_ok ? "" : "  MISMATCH") << "\n"
+              << std::setprecision(2)
+              << "packed vs protobuf: " << double(proto_out.size()) / packed_out.size() << "x smaller, "
+              << proto_encode_ms / packed_encode_ms << "x faster encode" << std::endl;
+    return proto_ok && packed_ok && edge_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,141 @@
+// Collision engine benchmark: the per-tick resolve loop (query, then move
+// if free) run against each CollisionEngine on the same inputs.
+//
+// Usage: collision_bench [--players N] [--ticks T] [--clusters K] [--sigma S]
+//
+// Distributions:
+//   uniform    players spread over a square with ~100 units per player
+//   clustered  players packed around K centres (normal, std dev S)
+// Every tick each player proposes a small step (+-8 units); moves are
+// resolved in ID order against MIN_PLAYER_DISTANCE. All engines must accept
+// the same number of moves.
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#include "../server/collision_engine.h"
+#include "../server/slot_map.h"
+#include "../common/config.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+struct Scenario {
+    std::string name;
+    std::vector<int> xs;
+    std::vector<int> ys;
+};
+
+static Scenario uniformScenario(int players, std::mt19937& rng) {
+    int side = static_cast<int>(std::sqrt(double(players)) * 100);
+    std::uniform_int_distribution<int> coord(0, side);
+    Scenario s{"uniform", std::vector<int>(players), std::vector<int>(players)};
+    for (int i = 0; i < players; ++i) {
+        s.xs[i] = coord(rng);
+        s.ys[i] = coord(rng);
+    }
+    return s;
+}
+
+static Scenario clusteredScenario(int players, int clusters, double sigma, std::mt19937& rng) {
+    std::uniform_int_distribution<int> centre(0, static_cast<int>(std::sqrt(double(players)) * 100));
+    std::normal_distribution<double> offset(0.0, sigma);
+    std::vector<int> cx(clusters), cy(clusters);
+    for (int c = 0; c < clusters; ++c) {
+        cx[c] = centre(rng);
+        cy[c] = centre(rng);
+    }
+    Scenario s{"clustered", std::vector<int>(players), std::vector<int>(players)};
+    for (int i = 0; i < players; ++i) {
+        s.xs[i] = cx[i % clusters] + static_cast<int>(offset(rng));
+        s.ys[i] = cy[i % clusters] + static_cast<int>(offset(rng));
+    }
+    return s;
+}
+
+int main(int argc, char** argv) {
+    int players = 10000;
+    int ticks = 20;
+    int clusters = 8;
+    double sigma = 300;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "--players") players = std::stoi(argv[i + 1]);
+        else if (arg == "--ticks") ticks = std::stoi(argv[i + 1]);
+        else if (arg == "--clusters") clusters = std::stoi(argv[i + 1]);
+        else if (arg == "--sigma") sigma = std::stod(argv[i + 1]);
+        else {
+            std::cerr << "Unknown option " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    std::mt19937 rng(42);
+    std::vector<Scenario> scenarios = {uniformScenario(players, rng),
+                                       clusteredScenario(players, clusters, sigma, rng)};
+
+    // Same proposed steps for every engine.
+    std::uniform_int_distribution<int> step(-8, 8);
+    std::vector<int> dx(static_cast<size_t>(players) * ticks), dy(dx.size());
+    for (size_t i = 0; i < dx.size(); ++i) {
+        dx[i] = step(rng);
+        dy[i] = step(rng);
+    }
+
+    // IDs as the server hands them out: slot i, generation 1.
+    std::vector<int> ids(players);
+    SlotMap<int> slots;
+    for (int i = 0; i < players; ++i) ids[i] = slots.insert(i);
+
+    std::cout << "players=" << players << " ticks=" << ticks << " clusters=" << clusters
+              << " sigma=" << sigma << " radius=" << MIN_PLAYER_DISTANCE << "\n";
+
+    for (const Scenario& s : scenarios) {
+        long expected = -1;
+        for (CollisionEngineType type : {CollisionEngineType::Grid, CollisionEngineType::SweepAndPrune}) {
+            std::unique_ptr<CollisionEngine> engine = makeCollisionEngine(type);
+            std::vector<int> xs = s.xs, ys = s.ys;
+
+            auto t0 = Clock::now();
+            for (int i = 0; i < players; ++i) engine->insert(ids[i], xs[i], ys[i]);
+            double build_ms = msSince(t0);
+
+            long accepted = 0;
+            t0 = Clock::now();
+            for (int t = 0; t < ticks; ++t) {
+                for (int i = 0; i < players; ++i) {
+                    size_t k = static_cast<size_t>(t) * players + i;
+                    int nx = xs[i] + dx[k];
+                    int ny = ys[i] + dy[k];
+                    if (!engine->anyWithin(nx, ny, MIN_PLAYER_DISTANCE, ids[i])) {
+                        engine->move(ids[i], nx, ny);
+                        xs[i] = nx;
+                        ys[i] = ny;
+                        accepted++;
+                    }
+                }
+            }
+            double resolve_ms = msSince(t0);
+            if (expected < 0) expected = accepted;
+
+            std::cout << std::fixed << std::setprecision(3)
+                      << std::left << std::setw(10) << s.name << std::setw(5) << engine->name() << std::right
+                      << " build " << build_ms << " ms  resolve " << resolve_ms * 1e6 / (double(players) * ticks)
+                      << " ns/player  accepted=" << accepted
+                      << (accepted != expected ? "  MISMATCH" : "") << std::endl;
+            if (accepted != expected) return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,106 @@
+// Proximity kernel microbenchmark: one query point against blocks of
+// candidates, the inner loop of a collision check.
+//
+// Usage: proximity_bench [--candidates N] [--queries Q] [--radius R] [--spread S]
+//
+// Candidates are uniform in a [-S, S] square. Every variant answers the same
+// queries and must agree on the number of hits. Variants:
+//   sqrt    the original loop: double-precision sqrt per candidate
+//   scalar  squared integer distance, one candidate at a time
+//   sse2 / avx2 / avx512  the SIMD kernels (skipped if the CPU lacks them)
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#include "../server/proximity_kernel.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Baseline: what isCollisionFree() did per candidate before the grid and kernel.
+static uint64_t sqrtMask(const int32_t* xs, const int32_t* ys, size_t n,
+                         int32_t qx, int32_t qy, int32_t radius) {
+    uint64_t mask = 0;
+    for (size_t i = 0; i < n; ++i) {
+        int dx = xs[i] - qx;
+        int dy = ys[i] - qy;
+        double distance = std::sqrt(dx * dx + dy * dy);
+        mask |= static_cast<uint64_t>(distance < radius) << i;
+    }
+    return mask;
+}
+
+int main(int argc, char** argv) {
+    size_t candidates = 4096;
+    long queries = 20000;
+    int radius = 50;
+    int spread = 1000;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "--candidates") candidates = std::stoul(argv[i + 1]);
+        else if (arg == "--queries") queries = std::stol(argv[i + 1]);
+        else if (arg == "--radius") radius = std::stoi(argv[i + 1]);
+        else if (arg == "--spread") spread = std::stoi(argv[i + 1]);
+        else {
+            std::cerr << "Unknown option " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int32_t> coord(-spread, spread);
+    std::vector<int32_t> xs(candidates), ys(candidates), qx(queries), qy(queries);
+    for (size_t i = 0; i < candidates; ++i) {
+        xs[i] = coord(rng);
+        ys[i] = coord(rng);
+    }
+    for (long q = 0; q < queries; ++q) {
+        qx[q] = coord(rng);
+        qy[q] = coord(rng);
+    }
+
+    struct Variant {
+        const char* name;
+        ProximityKernel kernel;
+    };
+    std::vector<Variant> variants = {{"sqrt", sqrtMask}};
+    for (ProximityIsa isa : {ProximityIsa::Scalar, ProximityIsa::Sse2, ProximityIsa::Avx2, ProximityIsa::Avx512}) {
+        if (ProximityKernel k = getProximityKernel(isa)) variants.push_back({proximityIsaName(isa), k});
+    }
+
+    std::cout << "candidates=" << candidates << " queries=" << queries << " radius=" << radius
+              << " spread=" << spread << " runtime kernel=" << proximityIsaName(detectProximityIsa()) << "\n";
+
+    double base_ns = 0;
+    long expected_hits = -1;
+    for (const Variant& v : variants) {
+        long hits = 0;
+        auto t0 = Clock::now();
+        for (long q = 0; q < queries; ++q) {
+            for (size_t base = 0; base < candidates; base += PROXIMITY_BLOCK) {
+                size_t n = candidates - base < PROXIMITY_BLOCK ? candidates - base : PROXIMITY_BLOCK;
+                hits += __builtin_popcountll(v.kernel(xs.data() + base, ys.data() + base, n, qx[q], qy[q], radius));
+            }
+        }
+        double ns = msSince(t0) * 1e6 / (double(queries) * candidates);
+        if (base_ns == 0) base_ns = ns;
+        if (expected_hits < 0) expected_hits = hits;
+
+        std::cout << std::fixed << std::setprecision(3)
+                  << std::left << std::setw(8) << v.name << std::right
+                  << ns << " ns/candidate  " << std::setprecision(2) << base_ns / ns << "x  hits=" << hits
+                  << (hits != expected_hits ? "  MISMATCH" : "") << std::endl;
+        if (hits != expected_hits) return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,332 @@
+// In-process server benchmark: drives GameManager through an
+// InMemoryTransport with synthetic clients, so the numbers are pure CPU cost
+// of the server logic without kernel or network noise.
+//
+// Usage: server_bench [--clients N] [--packets P] [--ticks T] [--aoi-radius R] [--ack 0|1]
+//                     [--codec protobuf|packed] [--encode-workers W]
+//                     [--client-budget B] [--update-tiers R:HZ,...,HZ]
+//
+// Phases:
+//   1. N clients send HELLO and are registered; the game starts.
+//   2. P ClientUpdate datagrams (pre-serialized) are parsed and handled, with
+//      one update() after every N packets to resolve the buffered moves.
+//   3. T ticks of update() + broadcastToAll() are run. Every tick a tenth of
+//      the clients move, and (with --ack 1) every client acknowledges the
+//      snapshot just broadcast, so later snapshots go out as deltas.
+//      Heap allocations inside broadcastToAll() are counted (global
+//      operator new is replaced) over the second half of the ticks, after
+//      the reused buffers have grown to size; steady state should be 0.
+// Server log output is discarded during the run. Per-client snapshot sizes
+// are reported for phase 3; --aoi-radius 0 sends the full world to everyone,
+// --codec is the snapshot encoding every client asks for in its HELLO, and
+// --encode-workers is the number of threads encoding clients in parallel
+// (time each of them spent encoding is reported per broadcast). With
+// --client-budget each client gets at most B bytes per snapshot and the
+// rest is deferred by priority; deferrals and starvation are reported.
+// --update-tiers sends changes of farther players at lower rates.
+// Before phase 1, snapshots with extreme IDs and coordinates are broadcast
+// and every datagram is compared with protobuf's own serialization; the run
+// fails on any difference. After phase 3 the server's tick history is diffed between the last two
+// ticks and between the oldest and newest retained tick.
+
+#include <atomic>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <chrono>
+#include <arpa/inet.h>
+
+#include "../server/game_manager.h"
+#include "../server/memory_transport.h"
+#include "../server/proximity_kernel.h"
+#include "../generated/game.pb.h"
+#include "../common/config.h"
+
+using Clock = std::chrono::steady_clock;
+
+// Counts every heap allocation in the process; the bench reads it around
+// the code under test.
+static std::atomic<uint64_t> allocations{0};
+
+void* operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+static double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static sockaddr_in syntheticAddr(int i) {
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(0x0A000000u + static_cast<uint32_t>(i / 50000));  // 10.0.0.x
+    addr.sin_port = htons(static_cast<uint16_t>(10000 + i % 50000));
+    return addr;
+}
+
+// Broadcasts two hand-made snapshots (a full one, then deltas with removed
+// IDs) whose players cover the encoding's extremes, and checks that every
+// datagram, including the hand-written protobuf parts, is byte-for-byte what
+// SerializeToString() produces for the same packet.
+static bool checkWireFormat(size_t& checked) {
+    const int32_t coords[] = {0, 1, -1, 127, -128, MAX_COORDINATE, -MAX_COORDINATE, INT32_MAX, INT32_MIN};
+    const int32_t generations[] = {0, 1, 2, 0x7F, 0x7FFF};  // Wire IDs up to INT32_MAX
+    const size_t n_coords = sizeof(coords) / sizeof(coords[0]);
+    WorldSnapshot snap;
+    snap.state = GameState::STARTED;
+    snap.tick = INT32_MAX;
+    for (int i = 0; i < 150; ++i) {  // Enough 32-byte entries to need several parts
+        SnapshotPlayer p{};
+        p.id = (generations[i % 5] << 16) | (i == 149 ? 0xFFFF : i);
+        p.x = coords[i % n_coords];
+        p.y = coords[(i / n_coords) % n_coords];
+        p.blocked = i % 3 == 0;
+        p.codec = PLAYER_CODEC_PROTOBUF;
+        p.addr = syntheticAddr(i);
+        snap.players.push_back(p);
+    }
+    sockaddr_in viewer = syntheticAddr(-1);
+
+    SnapshotBroadcaster broadcaster(0, 1, 0);
+    InMemoryTransport transport(true);
+    snap.sequence = 1;
+    broadcaster.broadcast(snap, transport, viewer);
+    // Second snapshot: some players leave, some move, half the clients have acked the first.
+    snap.sequence = 2;
+    snap.players.erase(snap.players.begin() + 10, snap.players.begin() + 20);
+    for (size_t i = 0; i < snap.players.size(); ++i) {
+        SnapshotPlayer& p = snap.players[i];
+        if (i % 4 == 0) p.x = coords[(i + 1) % n_coords];
+        if (i % 7 == 0) p.blocked = !p.blocked;
+        p.ack = i % 2 ? 1 : 0;
+    }
+    broadcaster.broadcast(snap, transport, viewer);
+
+    Packet packet;
+    std::string canonical;
+    checked = 0;
+    for (const InMemoryTransport::Datagram& d : transport.getSent()) {
+        if (!packet.ParseFromString(d.data) || !packet.has_state_packet()) return false;
+        packet.SerializeToString(&canonical);
+        if (canonical != d.data) return false;
+        checked++;
+    }
+    return checked > 0 && broadcaster.getStats().deltas > 0;
+}
+
+static std::string upper(std::string s) {
+    for (char& c : s) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    return s;
+}
+
+int main(int argc, char** argv) {
+    int clients = 1000;
+    long packets = 1000000;
+    int ticks = 50;
+    int aoi_radius = AOI_RADIUS;
+    bool ack = true;
+    PlayerCodec codec = PLAYER_CODEC_PROTOBUF;
+    unsigned encode_workers = ENCODE_WORKERS;
+    size_t client_budget = CLIENT_SNAPSHOT_BUDGET;
+    std::string update_tiers = UPDATE_TIERS;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "--clients") clients = std::stoi(argv[i + 1]);
+        else if (arg == "--packets") packets = std::stol(argv[i + 1]);
+        else if (arg == "--ticks") ticks = std::stoi(argv[i + 1]);
+        else if (arg == "--aoi-radius") aoi_radius = std::stoi(argv[i + 1]);
+        else if (arg == "--encode-workers") encode_workers = static_cast<unsigned>(std::stoul(argv[i + 1]));
+        else if (arg == "--client-budget") client_budget = std::stoul(argv[i + 1]);
+        else if (arg == "--update-tiers") update_tiers = argv[i + 1];
+        else if (arg == "--ack") ack = std::stoi(argv[i + 1]) != 0;
+        else if (arg == "--codec" && PlayerCodec_Parse("PLAYER_CODEC_" + upper(argv[i + 1]), &codec)) continue;
+        else {
+            std::cerr << "Unknown option " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    if (aoi_radius < 0 || aoi_radius > PROXIMITY_MAX_RADIUS) {
+        std::cerr << "Bad --aoi-radius " << aoi_radius << " (0 to " << PROXIMITY_MAX_RADIUS << ")" << std::endl;
+        return 1;
+    }
+    std::vector<UpdateTier> tiers;
+    if (!parseUpdateTiers(update_tiers, tiers)) {
+        std::cerr << "Bad --update-tiers " << update_tiers << std::endl;
+        return 1;
+    }
+
+    size_t wire_datagrams = 0;
+    if (!checkWireFormat(wire_datagrams)) {
+        std::cerr << "Snapshot datagrams differ from StatePacket::SerializeToString()" << std::endl;
+        return 1;
+    }
+
+    InMemoryTransport transport;
+    GameManager game(clients, 0, transport, CollisionEngineType::Grid, aoi_radius, encode_workers, client_budget, tiers);
+
+    // Silence per-packet server logging; restore for our own output.
+    std::streambuf* out = std::cout.rdbuf();
+    std::cout.rdbuf(nullptr);
+
+    // --- Phase 1: handshake ---
+    std::vector<sockaddr_in> addrs(clients);
+    std::vector<int> ids(clients, 0);
+    std::unordered_map<uint64_t, int> index_of;
+    for (int i = 0; i < clients; ++i) {
+        addrs[i] = syntheticAddr(i);
+        index_of[(uint64_t(addrs[i].sin_addr.s_addr) << 16) | addrs[i].sin_port] = i;
+    }
+    transport.setSink([&](const sockaddr_in& to, const char* data, size_t len) {
+        Packet reply;
+        if (reply.ParseFromArray(data, static_cast<int>(len)) && reply.has_welcome()) {
+            ids[index_of[(uint64_t(to.sin_addr.s_addr) << 16) | to.sin_port]] = reply.welcome().id();
+        }
+    });
+
+    Packet hello;
+    hello.mutable_hello()->set_codec(codec);
+    auto t0 = Clock::now();
+    for (int i = 0; i < clients; ++i) {
+        game.handleProtobufMessage(hello, addrs[i]);
+    }
+    double handshake_ms = msSince(t0);
+    transport.setSink(nullptr);
+    game.update();  // all players present -> STARTED
+
+    // --- Phase 2: client updates ---
+    // Clients sit on a 100-unit lattice and jitter around their spot, so a
+    // realistic share of moves passes the 50-unit collision check.
+    constexpr int VARIANTS = 4;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> jitter(-40, 40);
+    int side = 1;
+    while (side * side < clients) side++;
+
+    std::vector<std::string> datagrams;
+    datagrams.reserve(static_cast<size_t>(clients) * VARIANTS);
+    for (int v = 0; v < VARIANTS; ++v) {
+        for (int i = 0; i < clients; ++i) {
+            Packet p;
+            auto* u = p.mutable_client_update();
+            u->set_id(ids[i]);
+            u->set_x((i % side) * 100 + jitter(rng));
+            u->set_y((i / side) * 100 + jitter(rng));
+            datagrams.push_back(p.SerializeAsString());
+        }
+    }
+
+    Packet packet;
+    t0 = Clock::now();
+    for (long n = 0; n < packets; ++n) {
+        size_t k = static_cast<size_t>(n % static_cast<long>(datagrams.size()));
+        const std::string& d = datagrams[k];
+        if (!packet.ParseFromArray(d.data(), static_cast<int>(d.size()))) continue;
+        game.handleProtobufMessage(packet, addrs[k % clients]);
+        if ((n + 1) % clients == 0) game.update();  // Moves are applied at tick time
+    }
+    double packets_ms = msSince(t0);
+
+    // --- Phase 3: ticks ---
+    uint64_t bytes0 = transport.getBytes();
+    uint64_t dgrams0 = transport.getDatagrams();
+    const BroadcastStats before = game.getBroadcastStats();
+    Packet ping;
+    uint64_t broadcast_allocs = 0;
+    double broadcast_ms = 0;
+    t0 = Clock::now();
+    for (int t = 0; t < ticks; ++t) {
+        for (int i = t % 10; i < clients; i += 10) {
+            const std::string& d = datagrams[static_cast<size_t>((t / 10) % VARIANTS) * clients + i];
+            if (packet.ParseFromArray(d.data(), static_cast<int>(d.size()))) {
+                game.handleProtobufMessage(packet, addrs[i]);
+            }
+        }
+        game.update();
+        uint64_t allocs0 = allocations.load(std::memory_order_relaxed);
+        auto b0 = Clock::now();
+        game.broadcastToAll();
+        broadcast_ms += msSince(b0);
+        if (t >= ticks / 2) broadcast_allocs += allocations.load(std::memory_order_relaxed) - allocs0;
+        if (!ack) continue;
+        uint32_t seq = static_cast<uint32_t>(game.getPublishedSequence());
+        for (int i = 0; i < clients; ++i) {
+            ping.mutable_ping()->set_id(ids[i]);
+            ping.mutable_ping()->set_ack_seq(seq);
+            game.handleProtobufMessage(ping, addrs[i]);
+        }
+    }
+    double ticks_ms = msSince(t0);
+    const BroadcastStats& after = game.getBroadcastStats();
+    uint64_t snaps = after.snapshots - before.snapshots;
+    uint64_t bcasts = after.broadcasts - before.broadcasts;
+
+    const SnapshotHistory& history = game.getHistory();
+    std::vector<int32_t> changed, removed;
+    changed.reserve(clients);
+    removed.reserve(clients);
+    const int reps = 100;
+    auto h0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < reps; ++r) history.diff(history.newestTick() - 1, history.newestTick(), changed, removed);
+    double diff_last_ms = msSince(h0);
+    size_t changed_last = changed.size();
+    h0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < reps; ++r) history.diff(history.oldestTick(), history.newestTick(), changed, removed);
+    double diff_span_ms = msSince(h0);
+
+    std::cout.rdbuf(out);
+    std::cout << std::fixed << std::setprecision(3)
+              << "clients=" << clients << " packets=" << packets << " ticks=" << ticks << "\n"
+              << "wire:        " << wire_datagrams << " snapshot datagrams match SerializeToString()\n"
+              << "handshake:   " << handshake_ms * 1e6 / clients << " ns/client\n"
+              << "updates:     " << packets_ms * 1e6 / packets << " ns/packet incl. resolution ("
+              << packets / (packets_ms / 1e3) / 1e6 << " Mpkt/s)\n"
+              << "tick:        " << ticks_ms / ticks << " ms/tick (update + broadcast), "
+              << broadcast_ms / ticks << " ms/tick in broadcast\n"
+              << "broadcast:   " << double(transport.getDatagrams() - dgrams0) / ticks << " datagrams/tick, "
+              << double(transport.getBytes() - bytes0) / ticks / 1024 << " KiB/tick\n"
+              << "snapshot:    aoi_radius=" << aoi_radius << " codec=" << PlayerCodec_Name(codec) << " avg "
+              << double(after.bytes - before.bytes) / (snaps ? snaps : 1) << " B/client, "
+              << double(after.visible - before.visible) / (snaps ? snaps : 1) << " players/client, "
+              << double(after.encoded - before.encoded) / (snaps ? snaps : 1) << " encoded/client, "
+              << double(after.parts - before.parts) / (snaps ? snaps : 1) << " parts/client, "
+              << "delta " << after.deltas - before.deltas << "/" << snaps << ", "
+              << "full world " << double(after.fullStateBytes - before.fullStateBytes) / (bcasts ? bcasts : 1) << " B, "
+              << "over MTU " << after.overMtu - before.overMtu << ", "
+              << double(after.reencoded - before.reencoded) / (bcasts ? bcasts : 1) << " players re-encoded/broadcast\n"
+              << "budget:      " << client_budget << " B/client, limited " << after.budgetLimited - before.budgetLimited
+              << "/" << snaps << ", " << double(after.deferred - before.deferred) / (snaps ? snaps : 1)
+              << " deferred/client, max " << after.maxUnsentTicks << " ticks unsent\n"
+              << "tiers:       " << (update_tiers.empty() ? "off" : update_tiers) << ", "
+              << double(after.tierSkipped - before.tierSkipped) / (snaps ? snaps : 1) << " held back/client\n"
+              << "encode:      " << encode_workers << " worker(s), "
+              << double(after.encodeNs - before.encodeNs) / 1e6 / (bcasts ? bcasts : 1) << " ms/broadcast wall, busy ms";
+    for (unsigned w = 0; w < encode_workers && w < MAX_ENCODE_WORKERS; ++w) {
+        std::cout << (w ? "/" : " ") << double(after.workerBusyNs[w] - before.workerBusyNs[w]) / 1e6 / (bcasts ? bcasts : 1);
+    }
+    std::cout << ", steals";
+    for (unsigned w = 0; w < encode_workers && w < MAX_ENCODE_WORKERS; ++w) {
+        std::cout << (w ? "/" : " ") << after.workerSteals[w] - before.workerSteals[w];
+    }
+    std::cout << "\n"
+              << "history:     " << history.size() << "/" << history.capacity() << " ticks, diff last 2 "
+              << diff_last_ms * 1e3 / reps << " us (" << changed_last << " changed), diff "
+              << history.newestTick() - history.oldestTick() << " ticks apart " << diff_span_ms * 1e3 / reps
+              << " us (" << changed.size() << " changed, " << removed.size() << " removed)\n"
+              << "allocs:      " << double(broadcast_allocs) / (ticks - ticks / 2)
+              << " heap allocations/broadcast (steady state, last " << ticks - ticks / 2 << " ticks)" << std::endl;
+    return 0;
+}
@@ -6,16 +6,86 @@
 #include <thread>
 #include <chrono>
 #include <atomic>
+#include <map>
+#include <vector>
 
 #include "../generated/game.pb.h"
 #include "../common/config.h"
+#include "../common/player_codec.h"
 #define SERVER_PORT 9000
-#define BUFFER_SIZE 1024
+#define BUFFER_SIZE MAX_DATAGRAM_SIZE
 
 std::atomic<GameState> currentState(GameState::UNKNOWN);
+std::atomic<uint32_t> latestAck(0);  // Newest snapshot seq reconstructed, echoed to the server
+
+/**
+ * @brief Snapshot as reconstructed on the client, kept as a baseline for later deltas.
+ *
+ * A snapshot arrives as one or more parts; each part is applied as soon as
+ * it arrives, so a lost part only leaves its own players stale. Only a
+ * complete frame is acknowledged or used as a baseline.
+ */
+struct Frame {
+    uint32_t seq = 0;
+    std::map<int, Player> players;
+    std::vector<bool> received;  ///< Parts seen so far, indexed by part
+    uint32_t missing = 0;        ///< Parts not yet received
+
+    bool complete() const { return seq != 0 && missing == 0; }
+};
+
+enum class ApplyResult {
+    Applied,          ///< Part merged into its frame
+    Duplicate,        ///< Part already seen, or from a snapshot older than the slot holds
+    MissingBaseline,  ///< Delta against a frame that is gone or incomplete
+};
+
+/**
+ * @brief Applies one part of a state packet (full or delta) to the ring of recent frames.
+ */
+ApplyResult applyStatePacket(Frame (&frames)[DELTA_BASELINE_WINDOW], const StatePacket& sp) {
+    Frame& frame = frames[sp.seq() % DELTA_BASELINE_WINDOW];
+    const uint32_t count = sp.part_count() ? sp.part_count() : 1;
+    if (sp.seq() < frame.seq || sp.part() >= count) return ApplyResult::Duplicate;
+
+    if (sp.seq() != frame.seq) {  // First part of a new snapshot
+        if (sp.baseline_seq() == 0) {
+            frame.players.clear();
+        } else {
+            const Frame& base = frames[sp.baseline_seq() % DELTA_BASELINE_WINDOW];
+            if (base.seq != sp.baseline_seq() || !base.complete()) return ApplyResult::MissingBaseline;
+            if (&base != &frame) frame.players = base.players;
+        }
+        frame.seq = sp.seq();
+        frame.received.assign(count, false);
+        frame.missing = count;
+    }
+    if (frame.received[sp.part()]) return ApplyResult::Duplicate;
+    frame.received[sp.part()] = true;
+    frame.missing--;
+
+    for (int id : sp.removed()) frame.players.erase(id);
+    for (const auto& p : sp.players()) frame.players[p.id()] = p;
+    if (!sp.packed_players().empty()) {
+        static thread_local std::vector<PlayerRecord> records;
+        records.clear();
+        if (!decodePackedPlayers(sp.packed_players().data(), sp.packed_players().size(), records)) {
+            std::cout << "[WARN] Malformed packed players in snapshot " << sp.seq() << "\n";
+        }
+        for (const PlayerRecord& r : records) {
+            Player& p = frame.players[r.id];
+            p.set_id(r.id);
+            p.set_x(r.x);
+            p.set_y(r.y);
+            p.set_blocked(r.blocked);
+        }
+    }
+    return ApplyResult::Applied;
+}
 
 void receiverThread(int sockfd, sockaddr_in& recvaddr, socklen_t& addr_len) {
     char buffer[BUFFER_SIZE];
+    Frame frames[DELTA_BASELINE_WINDOW];
     while (true) {
         ssize_t r = recvfrom(sockfd, buffer, BUFFER_SIZE, 0, (sockaddr*)&recvaddr, &addr_len);
         if (r > 0) {
@@ -23,9 +93,26 @@ void receiverThread(int sockfd, sockaddr_in& recvaddr, socklen_t& addr_len) {
             if (incoming.ParseFromArray(buffer, r) && incoming.has_state_packet()) {
                 const auto& sp = incoming.state_packet();
                 currentState.store(sp.state());
-                std::cout << "[STATE] Tick: " << sp.tick() << ", Players: " << sp.players_size() << "\n";
-                for (const auto& p : sp.players()) {
-                    std::cout << " - Player " << p.id() << ": (" << p.x() << ", " << p.y() << ")\n";
+                ApplyResult result = applyStatePacket(frames, sp);
+                if (result == ApplyResult::MissingBaseline) {
+                    std::cout << "[WARN] Dropped delta " << sp.seq() << " against missing baseline "
+                              << sp.baseline_seq() << "\n";
+                    continue;
+                }
+                const Frame& frame = frames[sp.seq() % DELTA_BASELINE_WINDOW];
+                if (result != ApplyResult::Applied) continue;
+                if (!frame.complete()) {
+                    // Usable on its own: these players' positions are current.
+                    std::cout << "[STATE] Tick: " << sp.tick() << ", part " << sp.part() + 1 << "/"
+                              << sp.part_count() << ", Players: " << frame.players.size() << " (partial)\n";
+                    continue;
+                }
+
+                if (sp.seq() > latestAck.load()) latestAck.store(sp.seq());
+                std::cout << "[STATE] Tick: " << sp.tick() << ", Players: " << frame.players.size()
+                          << (sp.baseline_seq() ? " (delta)" : "") << "\n";
+                for (const auto& [id, p] : frame.players) {
+                    std::cout << " - Player " << id << ": (" << p.x() << ", " << p.y() << ")\n";
                 }
             }
         }
@@ -49,7 +136,7 @@ int main() {
 
     // Send HELLO packet
     Packet hello_pkt;
-    hello_pkt.mutable_hello();
+    hello_pkt.mutable_hello()->set_codec(PLAYER_CODEC_PACKED);
     std::string data;
     hello_pkt.SerializeToString(&data);
     sendto(sockfd, data.data(), data.size(), 0, (const sockaddr*)&servaddr, sizeof(servaddr));
@@ -62,7 +149,8 @@ int main() {
         return 1;
     }
     int client_id = p.welcome().id();
-    std::cout << "[WELCOME] Assigned ID: " << client_id << "\n";
+    std::cout << "[WELCOME] Assigned ID: " << client_id << ", codec: "
+              << PlayerCodec_Name(p.welcome().codec()) << "\n";
 
     int x = 0, y = 0;
     std::thread(receiverThread, sockfd, std::ref(recvaddr), std::ref(addr_len)).detach();
@@ -74,10 +162,12 @@ int main() {
             update->set_id(client_id);
             update->set_x(x);
             update->set_y(y);
+            update->set_ack_seq(latestAck.load());
             x += 5;
             y += 5;
         } else {
             outgoing.mutable_ping()->set_id(client_id);
+            outgoing.mutable_ping()->set_ack_seq(latestAck.load());
         }
 
         std::string out_data;
@@ -9,4 +9,26 @@ constexpr int BROADCAST_INTERVAL_MS = 100; // Interval for broadcasting game sta
 // Game configuration constants
 constexpr int MIN_PLAYERS = 2; // Minimum players to start the game
 constexpr int MAX_PLAYERS = 10000; // Maximum players allowed in the game
-constexpr int WAIT_TIME_SEC = 10; // Time to wait for players before starting the game
\ No newline at end of file
+constexpr int WAIT_TIME_SEC = 10; // Time to wait for players before starting the game
+constexpr int MAX_COORDINATE = 1 << 30; // Positions outside +-this are rejected (keeps 32-bit distance math exact)
+constexpr int MIN_PLAYER_DISTANCE = 50; // Players may not move closer than this to each other
+constexpr int COLLISION_CELL_SIZE = 64; // Spatial grid cell edge; must be >= MIN_PLAYER_DISTANCE
+constexpr unsigned COLLISION_GRID_BUCKETS = 16384; // Hash buckets in the spatial grid (power of two)
+constexpr int AOI_RADIUS = 500; // Clients only receive players within this distance (0 = whole world)
+constexpr unsigned SNAPSHOT_HISTORY_TICKS = 64; // Past ticks of player state kept on the server for lag compensation and replay
+constexpr unsigned DELTA_BASELINE_WINDOW = 16; // Snapshots remembered per client as delta baselines; older acks get a full snapshot
+constexpr unsigned CLIENT_SNAPSHOT_BUDGET = 0; // Bytes a client may be sent per snapshot; players over it are deferred by priority (0 = unlimited)
+constexpr int PRIORITY_DISTANCE_SCALE = 250; // Distance (and movement) at which a player's send priority weight halves
+constexpr const char* UPDATE_TIERS = ""; // Per-viewer update rates by distance, e.g. "200:10,400:5,1" (Hz; empty = every player every snapshot)
+constexpr unsigned ENCODE_WORKERS = 1; // Threads encoding per-client snapshots, including the tick thread (1 = serial)
+constexpr unsigned MAX_ENCODE_WORKERS = 64; // Upper bound for --encode-workers
+
+// Network I/O tuning
+constexpr int RECV_WORKERS = 1; // Receive threads, each with its own SO_REUSEPORT socket (1 = receive on the tick thread)
+constexpr int RECV_BATCH_SIZE = 64; // Max datagrams pulled per recvmmsg() call
+constexpr int MAX_DATAGRAM_SIZE = 1500; // Per-datagram receive buffer size (bytes)
+constexpr unsigned INPUT_QUEUE_CAPACITY = 65536; // Decoded inputs buffered between receive workers and the tick (power of two)
+constexpr unsigned URING_RECV_BUFFERS = 4096; // Provided receive buffers for the io_uring backend (power of two)
+constexpr int SNAPSHOT_MTU_PAYLOAD = 1200; // Largest snapshot datagram that avoids IP fragmentation on common paths
+constexpr int SOCKET_SNDBUF_BYTES = 4 * 1024 * 1024; // Send buffer sized for a full-table broadcast burst
+constexpr int STATS_LOG_INTERVAL_SEC = 10; // Interval for logging I/O statistics
@@ -0,0 +1,159 @@
+#include "player_codec.h"
+
+namespace {
+
+uint8_t bitsFor(int32_t min, int32_t max) {
+    uint32_t range = static_cast<uint32_t>(int64_t(max) - min);
+    return range ? static_cast<uint8_t>(32 - __builtin_clz(range)) : 0;
+}
+
+uint32_t zigzag(int32_t v) {
+    return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31);
+}
+
+int32_t unzigzag(uint32_t v) {
+    return static_cast<int32_t>((v >> 1) ^ (0u - (v & 1)));
+}
+
+void putVarint(std::string& out, uint32_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<char>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<char>(v));
+}
+
+bool getVarint(const uint8_t*& p, const uint8_t* end, uint32_t& v) {
+    v = 0;
+    for (unsigned shift = 0; shift < 35 && p < end; shift += 7) {
+        uint8_t byte = *p++;
+        v |= uint32_t(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+}  // namespace
+
+void PackedBoundsBuilder::add(int32_t id, int32_t x, int32_t y) {
+    if (empty) {
+        minId = maxId = id;
+        minX = maxX = x;
+        minY = maxY = y;
+        empty = false;
+        return;
+    }
+    if (id < minId) minId = id;
+    if (id > maxId) maxId = id;
+    if (x < minX) minX = x;
+    if (x > maxX) maxX = x;
+    if (y < minY) minY = y;
+    if (y > maxY) maxY = y;
+}
+
+PackedBounds PackedBoundsBuilder::bounds() const {
+    PackedBounds b;
+    if (empty) return b;
+    b.minId = minId;
+    b.minX = minX;
+    b.minY = minY;
+    b.idBits = bitsFor(minId, maxId);
+    b.xBits = bitsFor(minX, maxX);
+    b.yBits = bitsFor(minY, maxY);
+    return b;
+}
+
+void PackedPlayerEncoder::begin(std::string& dst, const PackedBounds& b, uint32_t count) {
+    out = &dst;
+    bounds = b;
+    acc = 0;
+    accBits = 0;
+    dst.clear();
+    putVarint(dst, count);
+    putVarint(dst, zigzag(b.minId));
+    putVarint(dst, zigzag(b.minX));
+    putVarint(dst, zigzag(b.minY));
+    dst.push_back(static_cast<char>(b.idBits));
+    dst.push_back(static_cast<char>(b.xBits));
+    dst.push_back(static_cast<char>(b.yBits));
+    // Size for every player plus one spare word, so put() can store whole words.
+    pos = dst.size();
+    dst.resize(pos + (size_t(count) * b.playerBits() + 7) / 8 + 4);
+}
+
+void PackedPlayerEncoder::put(uint64_t value, unsigned bits) {
+    // Fields are at most 32 bits and accBits < 32, so the sum fits the accumulator.
+    acc |= value << accBits;
+    accBits += bits;
+    if (accBits >= 32) {
+        char* p = &(*out)[pos];
+        p[0] = static_cast<char>(acc);
+        p[1] = static_cast<char>(acc >> 8);
+        p[2] = static_cast<char>(acc >> 16);
+        p[3] = static_cast<char>(acc >> 24);
+        pos += 4;
+        acc >>= 32;
+        accBits -= 32;
+    }
+}
+
+void PackedPlayerEncoder::add(int32_t id, int32_t x, int32_t y, bool blocked) {
+    put(static_cast<uint32_t>(int64_t(id) - bounds.minId), bounds.idBits);
+    put(static_cast<uint32_t>(int64_t(x) - bounds.minX), bounds.xBits);
+    put(static_cast<uint32_t>(int64_t(y) - bounds.minY), bounds.yBits);
+    put(blocked ? 1 : 0, 1);
+}
+
+void PackedPlayerEncoder::finish() {
+    for (; accBits > 0; accBits = accBits > 8 ? accBits - 8 : 0) {
+        (*out)[pos++] = static_cast<char>(acc);
+        acc >>= 8;
+    }
+    out->resize(pos);
+    acc = 0;
+    accBits = 0;
+}
+
+bool decodePackedPlayers(const void* data, size_t len, std::vector<PlayerRecord>& out) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    const uint8_t* end = p + len;
+
+    uint32_t count, min_id, min_x, min_y;
+    if (!getVarint(p, end, count) || !getVarint(p, end, min_id) ||
+        !getVarint(p, end, min_x) || !getVarint(p, end, min_y) || end - p < 3) {
+        return false;
+    }
+    PackedBounds b;
+    b.minId = unzigzag(min_id);
+    b.minX = unzigzag(min_x);
+    b.minY = unzigzag(min_y);
+    b.idBits = *p++;
+    b.xBits = *p++;
+    b.yBits = *p++;
+    if (b.idBits > 32 || b.xBits > 32 || b.yBits > 32) return false;
+    if ((size_t(count) * b.playerBits() + 7) / 8 > size_t(end - p)) return false;
+
+    uint64_t acc = 0;
+    unsigned acc_bits = 0;
+    auto take = [&](unsigned bits) -> uint32_t {
+        while (acc_bits < bits) {
+            acc |= uint64_t(*p++) << acc_bits;
+            acc_bits += 8;
+        }
+        uint32_t v = bits ? static_cast<uint32_t>(acc & (~0ull >> (64 - bits))) : 0;
+        acc >>= bits;
+        acc_bits -= bits;
+        return v;
+    };
+
+    out.reserve(out.size() + count);
+    for (uint32_t i = 0; i < count; ++i) {
+        PlayerRecord r;
+        r.id = static_cast<int32_t>(b.minId + int64_t(take(b.idBits)));
+        r.x = static_cast<int32_t>(b.minX + int64_t(take(b.xBits)));
+        r.y = static_cast<int32_t>(b.minY + int64_t(take(b.yBits)));
+        r.blocked = take(1) != 0;
+        out.push_back(r);
+    }
+    return true;
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Player fields as carried by a snapshot, independent of the wire codec.
+ */
+struct PlayerRecord {
+    int32_t id = 0;
+    int32_t x = 0;
+    int32_t y = 0;
+    bool blocked = false;
+};
+
+/**
+ * @brief Value ranges of one packed block: every field is stored as an
+ * offset from its minimum, in just enough bits for the largest offset.
+ */
+struct PackedBounds {
+    int32_t minId = 0;
+    int32_t minX = 0;
+    int32_t minY = 0;
+    uint8_t idBits = 0;
+    uint8_t xBits = 0;
+    uint8_t yBits = 0;
+
+    /**
+     * @brief Bits one player takes in the block (the blocked flag is the last bit).
+     */
+    size_t playerBits() const { return size_t(idBits) + xBits + yBits + 1; }
+};
+
+/**
+ * @brief Largest header PackedPlayerEncoder::begin() writes before the player bits.
+ */
+constexpr size_t PACKED_HEADER_MAX_BYTES = 5 + 3 * 5 + 3;
+
+/**
+ * @brief Accumulates the bounds of the players that will share one packed block.
+ */
+class PackedBoundsBuilder {
+public:
+    void add(int32_t id, int32_t x, int32_t y);
+
+    /**
+     * @brief Bounds covering every player added so far (all zero if none).
+     */
+    PackedBounds bounds() const;
+
+private:
+    bool empty = true;
+    int32_t minId = 0, maxId = 0;
+    int32_t minX = 0, maxX = 0;
+    int32_t minY = 0, maxY = 0;
+};
+
+/**
+ * @brief Writes players as a bit-packed block (PLAYER_CODEC_PACKED).
+ *
+ * Layout: varint player count, zigzag varint minId/minX/minY, one byte each
+ * for idBits/xBits/yBits, then per player the id, x and y offsets and the
+ * blocked flag, packed LSB-first with no padding until the final byte.
+ * Positions are quantized to the block's bounding box, which is exact for
+ * integer coordinates; with players spread over a few thousand units a
+ * player costs 4-5 bytes instead of protobuf's 10-12.
+ *
+ * Writes into a caller-owned string that keeps its capacity between blocks.
+ */
+class PackedPlayerEncoder {
+public:
+    /**
+     * @brief Starts a block of `count` players in `out` (previous contents are replaced).
+     */
+    void begin(std::string& out, const PackedBounds& bounds, uint32_t count);
+
+    /**
+     * @brief Appends one player; its fields must lie within the bounds.
+     */
+    void add(int32_t id, int32_t x, int32_t y, bool blocked);
+
+    /**
+     * @brief Flushes the last partial byte. Must be called after the last add().
+     */
+    void finish();
+
+private:
+    void put(uint64_t value, unsigned bits);
+
+    std::string* out = nullptr;
+    size_t pos = 0;         ///< Next byte to write in *out (sized up front by begin())
+    PackedBounds bounds;
+    uint64_t acc = 0;
+    unsigned accBits = 0;   ///< Pending bits in acc, always below 32 between calls
+};
+
+/**
+ * @brief Decodes a block written by PackedPlayerEncoder, appending to `out`.
+ * @return false if the block is truncated or malformed (`out` may hold a prefix).
+ */
+bool decodePackedPlayers(const void* data, size_t len, std::vector<PlayerRecord>& out);
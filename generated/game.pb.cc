@@ -37,7 +37,9 @@ struct PlayerDefaultTypeInternal {
 };
 PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 PlayerDefaultTypeInternal _Player_default_instance_;
 PROTOBUF_CONSTEXPR Hello::Hello(
-    ::_pbi::ConstantInitialized) {}
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_.codec_)*/0
+  , /*decltype(_impl_._cached_size_)*/{}} {}
 struct HelloDefaultTypeInternal {
   PROTOBUF_CONSTEXPR HelloDefaultTypeInternal()
       : _instance(::_pbi::ConstantInitialized{}) {}
@@ -50,6 +52,7 @@ PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORIT
 PROTOBUF_CONSTEXPR Ping::Ping(
     ::_pbi::ConstantInitialized): _impl_{
     /*decltype(_impl_.id_)*/0
+  , /*decltype(_impl_.ack_seq_)*/0u
   , /*decltype(_impl_._cached_size_)*/{}} {}
 struct PingDefaultTypeInternal {
   PROTOBUF_CONSTEXPR PingDefaultTypeInternal()
@@ -65,6 +68,7 @@ PROTOBUF_CONSTEXPR ClientUpdate::ClientUpdate(
     /*decltype(_impl_.id_)*/0
   , /*decltype(_impl_.x_)*/0
   , /*decltype(_impl_.y_)*/0
+  , /*decltype(_impl_.ack_seq_)*/0u
   , /*decltype(_impl_._cached_size_)*/{}} {}
 struct ClientUpdateDefaultTypeInternal {
   PROTOBUF_CONSTEXPR ClientUpdateDefaultTypeInternal()
@@ -78,6 +82,7 @@ PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORIT
 PROTOBUF_CONSTEXPR Welcome::Welcome(
     ::_pbi::ConstantInitialized): _impl_{
     /*decltype(_impl_.id_)*/0
+  , /*decltype(_impl_.codec_)*/0
   , /*decltype(_impl_._cached_size_)*/{}} {}
 struct WelcomeDefaultTypeInternal {
   PROTOBUF_CONSTEXPR WelcomeDefaultTypeInternal()
@@ -91,8 +96,15 @@ PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORIT
 PROTOBUF_CONSTEXPR StatePacket::StatePacket(
     ::_pbi::ConstantInitialized): _impl_{
     /*decltype(_impl_.players_)*/{}
+  , /*decltype(_impl_.removed_)*/{}
+  , /*decltype(_impl_._removed_cached_byte_size_)*/{0}
+  , /*decltype(_impl_.packed_players_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
   , /*decltype(_impl_.state_)*/0
   , /*decltype(_impl_.tick_)*/0
+  , /*decltype(_impl_.seq_)*/0u
+  , /*decltype(_impl_.baseline_seq_)*/0u
+  , /*decltype(_impl_.part_)*/0u
+  , /*decltype(_impl_.part_count_)*/0u
   , /*decltype(_impl_._cached_size_)*/{}} {}
 struct StatePacketDefaultTypeInternal {
   PROTOBUF_CONSTEXPR StatePacketDefaultTypeInternal()
@@ -118,7 +130,7 @@ struct PacketDefaultTypeInternal {
 };
 PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 PacketDefaultTypeInternal _Packet_default_instance_;
 static ::_pb::Metadata file_level_metadata_game_2eproto[7];
-static const ::_pb::EnumDescriptor* file_level_enum_descriptors_game_2eproto[1];
+static const ::_pb::EnumDescriptor* file_level_enum_descriptors_game_2eproto[2];
 static constexpr ::_pb::ServiceDescriptor const** file_level_service_descriptors_game_2eproto = nullptr;
 
 const uint32_t TableStruct_game_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
@@ -138,6 +150,7 @@ const uint32_t TableStruct_game_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(pro
   ~0u,  // no _oneof_case_
   ~0u,  // no _weak_field_map_
   ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::Hello, _impl_.codec_),
   ~0u,  // no _has_bits_
   PROTOBUF_FIELD_OFFSET(::Ping, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -145,6 +158,7 @@ const uint32_t TableStruct_game_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(pro
   ~0u,  // no _weak_field_map_
   ~0u,  // no _inlined_string_donated_
   PROTOBUF_FIELD_OFFSET(::Ping, _impl_.id_),
+  PROTOBUF_FIELD_OFFSET(::Ping, _impl_.ack_seq_),
   ~0u,  // no _has_bits_
   PROTOBUF_FIELD_OFFSET(::ClientUpdate, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -154,6 +168,7 @@ const uint32_t TableStruct_game_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(pro
   PROTOBUF_FIELD_OFFSET(::ClientUpdate, _impl_.id_),
   PROTOBUF_FIELD_OFFSET(::ClientUpdate, _impl_.x_),
   PROTOBUF_FIELD_OFFSET(::ClientUpdate, _impl_.y_),
+  PROTOBUF_FIELD_OFFSET(::ClientUpdate, _impl_.ack_seq_),
   ~0u,  // no _has_bits_
   PROTOBUF_FIELD_OFFSET(::Welcome, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -161,6 +176,7 @@ const uint32_t TableStruct_game_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(pro
   ~0u,  // no _weak_field_map_
   ~0u,  // no _inlined_string_donated_
   PROTOBUF_FIELD_OFFSET(::Welcome, _impl_.id_),
+  PROTOBUF_FIELD_OFFSET(::Welcome, _impl_.codec_),
   ~0u,  // no _has_bits_
   PROTOBUF_FIELD_OFFSET(::StatePacket, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -170,6 +186,12 @@ const uint32_t TableStruct_game_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(pro
   PROTOBUF_FIELD_OFFSET(::StatePacket, _impl_.state_),
   PROTOBUF_FIELD_OFFSET(::StatePacket, _impl_.tick_),
   PROTOBUF_FIELD_OFFSET(::StatePacket, _impl_.players_),
+  PROTOBUF_FIELD_OFFSET(::StatePacket, _impl_.seq_),
+  PROTOBUF_FIELD_OFFSET(::StatePacket, _impl_.baseline_seq_),
+  PROTOBUF_FIELD_OFFSET(::StatePacket, _impl_.removed_),
+  PROTOBUF_FIELD_OFFSET(::StatePacket, _impl_.part_),
+  PROTOBUF_FIELD_OFFSET(::StatePacket, _impl_.part_count_),
+  PROTOBUF_FIELD_OFFSET(::StatePacket, _impl_.packed_players_),
   ~0u,  // no _has_bits_
   PROTOBUF_FIELD_OFFSET(::Packet, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -186,11 +208,11 @@ const uint32_t TableStruct_game_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(pro
 static const ::_pbi::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
   { 0, -1, -1, sizeof(::Player)},
   { 10, -1, -1, sizeof(::Hello)},
-  { 16, -1, -1, sizeof(::Ping)},
-  { 23, -1, -1, sizeof(::ClientUpdate)},
-  { 32, -1, -1, sizeof(::Welcome)},
-  { 39, -1, -1, sizeof(::StatePacket)},
-  { 48, -1, -1, sizeof(::Packet)},
+  { 17, -1, -1, sizeof(::Ping)},
+  { 25, -1, -1, sizeof(::ClientUpdate)},
+  { 35, -1, -1, sizeof(::Welcome)},
+  { 43, -1, -1, sizeof(::StatePacket)},
+  { 58, -1, -1, sizeof(::Packet)},
 };
 
 static const ::_pb::Message* const file_default_instances[] = {
@@ -205,22 +227,29 @@ static const ::_pb::Message* const file_default_instances[] = {
 
 const char descriptor_table_protodef_game_2eproto[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) =
   "\n\ngame.proto\";\n\006Player\022\n\n\002id\030\001 \001(\005\022\t\n\001x\030"
-  "\002 \001(\005\022\t\n\001y\030\003 \001(\005\022\017\n\007blocked\030\004 \001(\010\"\007\n\005Hel"
-  "lo\"\022\n\004Ping\022\n\n\002id\030\001 \001(\005\"0\n\014ClientUpdate\022\n"
-  "\n\002id\030\001 \001(\005\022\t\n\001x\030\002 \001(\005\022\t\n\001y\030\003 \001(\005\"\025\n\007Welc"
-  "ome\022\n\n\002id\030\001 \001(\005\"P\n\013StatePacket\022\031\n\005state\030"
-  "\001 \001(\0162\n.GameState\022\014\n\004tick\030\002 \001(\005\022\030\n\007playe"
-  "rs\030\003 \003(\0132\007.Player\"\256\001\n\006Packet\022\027\n\005hello\030\001 "
-  "\001(\0132\006.HelloH\000\022\025\n\004ping\030\002 \001(\0132\005.PingH\000\022&\n\r"
-  "client_update\030\003 \001(\0132\r.ClientUpdateH\000\022\033\n\007"
-  "welcome\030\004 \001(\0132\010.WelcomeH\000\022$\n\014state_packe"
-  "t\030\005 \001(\0132\014.StatePacketH\000B\t\n\007payload*=\n\tGa"
-  "meState\022\013\n\007UNKNOWN\020\000\022\013\n\007WAITING\020\001\022\013\n\007STA"
-  "RTED\020\002\022\t\n\005ENDED\020\003b\006proto3"
+  "\002 \001(\005\022\t\n\001y\030\003 \001(\005\022\017\n\007blocked\030\004 \001(\010\"$\n\005Hel"
+  "lo\022\033\n\005codec\030\001 \001(\0162\014.PlayerCodec\"#\n\004Ping\022"
+  "\n\n\002id\030\001 \001(\005\022\017\n\007ack_seq\030\002 \001(\r\"A\n\014ClientUp"
+  "date\022\n\n\002id\030\001 \001(\005\022\t\n\001x\030\002 \001(\005\022\t\n\001y\030\003 \001(\005\022\017"
+  "\n\007ack_seq\030\004 \001(\r\"2\n\007Welcome\022\n\n\002id\030\001 \001(\005\022\033"
+  "\n\005codec\030\002 \001(\0162\014.PlayerCodec\"\276\001\n\013StatePac"
+  "ket\022\031\n\005state\030\001 \001(\0162\n.GameState\022\014\n\004tick\030\002"
+  " \001(\005\022\030\n\007players\030\003 \003(\0132\007.Player\022\013\n\003seq\030\004 "
+  "\001(\r\022\024\n\014baseline_seq\030\005 \001(\r\022\017\n\007removed\030\006 \003"
+  "(\005\022\014\n\004part\030\007 \001(\r\022\022\n\npart_count\030\010 \001(\r\022\026\n\016"
+  "packed_players\030\t \001(\014\"\256\001\n\006Packet\022\027\n\005hello"
+  "\030\001 \001(\0132\006.HelloH\000\022\025\n\004ping\030\002 \001(\0132\005.PingH\000\022"
+  "&\n\rclient_update\030\003 \001(\0132\r.ClientUpdateH\000\022"
+  "\033\n\007welcome\030\004 \001(\0132\010.WelcomeH\000\022$\n\014state_pa"
+  "cket\030\005 \001(\0132\014.StatePacketH\000B\t\n\007payload*=\n"
+  "\tGameState\022\013\n\007UNKNOWN\020\000\022\013\n\007WAITING\020\001\022\013\n\007"
+  "STARTED\020\002\022\t\n\005ENDED\020\003*A\n\013PlayerCodec\022\031\n\025P"
+  "LAYER_CODEC_PROTOBUF\020\000\022\027\n\023PLAYER_CODEC_P"
+  "ACKED\020\001b\006proto3"
   ;
 static ::_pbi::once_flag descriptor_table_game_2eproto_once;
 const ::_pbi::DescriptorTable descriptor_table_game_2eproto = {
-    false, false, 505, descriptor_table_protodef_game_2eproto,
+    false, false, 775, descriptor_table_protodef_game_2eproto,
     "game.proto",
     &descriptor_table_game_2eproto_once, nullptr, 0, 7,
     schemas, file_default_instances, TableStruct_game_2eproto::offsets,
@@ -249,6 +278,20 @@ bool GameState_IsValid(int value) {
   }
 }
 
+const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* PlayerCodec_descriptor() {
+  ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&descriptor_table_game_2eproto);
+  return file_level_enum_descriptors_game_2eproto[1];
+}
+bool PlayerCodec_IsValid(int value) {
+  switch (value) {
+    case 0:
+    case 1:
+      return true;
+    default:
+      return false;
+  }
+}
+
 
 // ===================================================================
 
@@ -517,31 +560,172 @@ class Hello::_Internal {
 
 Hello::Hello(::PROTOBUF_NAMESPACE_ID::Arena* arena,
                          bool is_message_owned)
-  : ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase(arena, is_message_owned) {
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
   // @@protoc_insertion_point(arena_constructor:Hello)
 }
 Hello::Hello(const Hello& from)
-  : ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase() {
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
   Hello* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_.codec_){}
+    , /*decltype(_impl_._cached_size_)*/{}};
+
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _this->_impl_.codec_ = from._impl_.codec_;
   // @@protoc_insertion_point(copy_constructor:Hello)
 }
 
+inline void Hello::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_.codec_){0}
+    , /*decltype(_impl_._cached_size_)*/{}
+  };
+}
+
+Hello::~Hello() {
+  // @@protoc_insertion_point(destructor:Hello)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void Hello::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+}
+
+void Hello::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void Hello::Clear() {
+// @@protoc_insertion_point(message_clear_start:Hello)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.codec_ = 0;
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* Hello::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // .PlayerCodec codec = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 8)) {
+          uint64_t val = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+          _internal_set_codec(static_cast<::PlayerCodec>(val));
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* Hello::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:Hello)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
 
+  // .PlayerCodec codec = 1;
+  if (this->_internal_codec() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteEnumToArray(
+      1, this->_internal_codec(), target);
+  }
 
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:Hello)
+  return target;
+}
 
+size_t Hello::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:Hello)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // .PlayerCodec codec = 1;
+  if (this->_internal_codec() != 0) {
+    total_size += 1 +
+      ::_pbi::WireFormatLite::EnumSize(this->_internal_codec());
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
 
 const ::PROTOBUF_NAMESPACE_ID::Message::ClassData Hello::_class_data_ = {
-    ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::CopyImpl,
-    ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::MergeImpl,
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    Hello::MergeImpl
 };
 const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*Hello::GetClassData() const { return &_class_data_; }
 
 
+void Hello::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<Hello*>(&to_msg);
+  auto& from = static_cast<const Hello&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:Hello)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
 
+  if (from._internal_codec() != 0) {
+    _this->_internal_set_codec(from._internal_codec());
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
 
+void Hello::CopyFrom(const Hello& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:Hello)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
 
+bool Hello::IsInitialized() const {
+  return true;
+}
 
+void Hello::InternalSwap(Hello* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_.codec_, other->_impl_.codec_);
+}
 
 ::PROTOBUF_NAMESPACE_ID::Metadata Hello::GetMetadata() const {
   return ::_pbi::AssignDescriptors(
@@ -566,10 +750,13 @@ Ping::Ping(const Ping& from)
   Ping* const _this = this; (void)_this;
   new (&_impl_) Impl_{
       decltype(_impl_.id_){}
+    , decltype(_impl_.ack_seq_){}
     , /*decltype(_impl_._cached_size_)*/{}};
 
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
-  _this->_impl_.id_ = from._impl_.id_;
+  ::memcpy(&_impl_.id_, &from._impl_.id_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.ack_seq_) -
+    reinterpret_cast<char*>(&_impl_.id_)) + sizeof(_impl_.ack_seq_));
   // @@protoc_insertion_point(copy_constructor:Ping)
 }
 
@@ -579,6 +766,7 @@ inline void Ping::SharedCtor(
   (void)is_message_owned;
   new (&_impl_) Impl_{
       decltype(_impl_.id_){0}
+    , decltype(_impl_.ack_seq_){0u}
     , /*decltype(_impl_._cached_size_)*/{}
   };
 }
@@ -606,7 +794,9 @@ void Ping::Clear() {
   // Prevent compiler warnings about cached_has_bits being unused
   (void) cached_has_bits;
 
-  _impl_.id_ = 0;
+  ::memset(&_impl_.id_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&_impl_.ack_seq_) -
+      reinterpret_cast<char*>(&_impl_.id_)) + sizeof(_impl_.ack_seq_));
   _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
@@ -624,6 +814,14 @@ const char* Ping::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
         } else
           goto handle_unusual;
         continue;
+      // uint32 ack_seq = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 16)) {
+          _impl_.ack_seq_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       default:
         goto handle_unusual;
     }  // switch
@@ -659,6 +857,12 @@ uint8_t* Ping::_InternalSerialize(
     target = ::_pbi::WireFormatLite::WriteInt32ToArray(1, this->_internal_id(), target);
   }
 
+  // uint32 ack_seq = 2;
+  if (this->_internal_ack_seq() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(2, this->_internal_ack_seq(), target);
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
@@ -680,6 +884,11 @@ size_t Ping::ByteSizeLong() const {
     total_size += ::_pbi::WireFormatLite::Int32SizePlusOne(this->_internal_id());
   }
 
+  // uint32 ack_seq = 2;
+  if (this->_internal_ack_seq() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_ack_seq());
+  }
+
   return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
@@ -701,6 +910,9 @@ void Ping::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_
   if (from._internal_id() != 0) {
     _this->_internal_set_id(from._internal_id());
   }
+  if (from._internal_ack_seq() != 0) {
+    _this->_internal_set_ack_seq(from._internal_ack_seq());
+  }
   _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
@@ -718,7 +930,12 @@ bool Ping::IsInitialized() const {
 void Ping::InternalSwap(Ping* other) {
   using std::swap;
   _internal_metadata_.InternalSwap(&other->_internal_metadata_);
-  swap(_impl_.id_, other->_impl_.id_);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(Ping, _impl_.ack_seq_)
+      + sizeof(Ping::_impl_.ack_seq_)
+      - PROTOBUF_FIELD_OFFSET(Ping, _impl_.id_)>(
+          reinterpret_cast<char*>(&_impl_.id_),
+          reinterpret_cast<char*>(&other->_impl_.id_));
 }
 
 ::PROTOBUF_NAMESPACE_ID::Metadata Ping::GetMetadata() const {
@@ -746,12 +963,13 @@ ClientUpdate::ClientUpdate(const ClientUpdate& from)
       decltype(_impl_.id_){}
     , decltype(_impl_.x_){}
     , decltype(_impl_.y_){}
+    , decltype(_impl_.ack_seq_){}
     , /*decltype(_impl_._cached_size_)*/{}};
 
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
   ::memcpy(&_impl_.id_, &from._impl_.id_,
-    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.y_) -
-    reinterpret_cast<char*>(&_impl_.id_)) + sizeof(_impl_.y_));
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.ack_seq_) -
+    reinterpret_cast<char*>(&_impl_.id_)) + sizeof(_impl_.ack_seq_));
   // @@protoc_insertion_point(copy_constructor:ClientUpdate)
 }
 
@@ -763,6 +981,7 @@ inline void ClientUpdate::SharedCtor(
       decltype(_impl_.id_){0}
     , decltype(_impl_.x_){0}
     , decltype(_impl_.y_){0}
+    , decltype(_impl_.ack_seq_){0u}
     , /*decltype(_impl_._cached_size_)*/{}
   };
 }
@@ -791,8 +1010,8 @@ void ClientUpdate::Clear() {
   (void) cached_has_bits;
 
   ::memset(&_impl_.id_, 0, static_cast<size_t>(
-      reinterpret_cast<char*>(&_impl_.y_) -
-      reinterpret_cast<char*>(&_impl_.id_)) + sizeof(_impl_.y_));
+      reinterpret_cast<char*>(&_impl_.ack_seq_) -
+      reinterpret_cast<char*>(&_impl_.id_)) + sizeof(_impl_.ack_seq_));
   _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
@@ -826,6 +1045,14 @@ const char* ClientUpdate::_InternalParse(const char* ptr, ::_pbi::ParseContext*
         } else
           goto handle_unusual;
         continue;
+      // uint32 ack_seq = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 32)) {
+          _impl_.ack_seq_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       default:
         goto handle_unusual;
     }  // switch
@@ -873,6 +1100,12 @@ uint8_t* ClientUpdate::_InternalSerialize(
     target = ::_pbi::WireFormatLite::WriteInt32ToArray(3, this->_internal_y(), target);
   }
 
+  // uint32 ack_seq = 4;
+  if (this->_internal_ack_seq() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(4, this->_internal_ack_seq(), target);
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
@@ -904,6 +1137,11 @@ size_t ClientUpdate::ByteSizeLong() const {
     total_size += ::_pbi::WireFormatLite::Int32SizePlusOne(this->_internal_y());
   }
 
+  // uint32 ack_seq = 4;
+  if (this->_internal_ack_seq() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_ack_seq());
+  }
+
   return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
@@ -931,6 +1169,9 @@ void ClientUpdate::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::P
   if (from._internal_y() != 0) {
     _this->_internal_set_y(from._internal_y());
   }
+  if (from._internal_ack_seq() != 0) {
+    _this->_internal_set_ack_seq(from._internal_ack_seq());
+  }
   _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
@@ -949,8 +1190,8 @@ void ClientUpdate::InternalSwap(ClientUpdate* other) {
   using std::swap;
   _internal_metadata_.InternalSwap(&other->_internal_metadata_);
   ::PROTOBUF_NAMESPACE_ID::internal::memswap<
-      PROTOBUF_FIELD_OFFSET(ClientUpdate, _impl_.y_)
-      + sizeof(ClientUpdate::_impl_.y_)
+      PROTOBUF_FIELD_OFFSET(ClientUpdate, _impl_.ack_seq_)
+      + sizeof(ClientUpdate::_impl_.ack_seq_)
       - PROTOBUF_FIELD_OFFSET(ClientUpdate, _impl_.id_)>(
           reinterpret_cast<char*>(&_impl_.id_),
           reinterpret_cast<char*>(&other->_impl_.id_));
@@ -979,10 +1220,13 @@ Welcome::Welcome(const Welcome& from)
   Welcome* const _this = this; (void)_this;
   new (&_impl_) Impl_{
       decltype(_impl_.id_){}
+    , decltype(_impl_.codec_){}
     , /*decltype(_impl_._cached_size_)*/{}};
 
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
-  _this->_impl_.id_ = from._impl_.id_;
+  ::memcpy(&_impl_.id_, &from._impl_.id_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.codec_) -
+    reinterpret_cast<char*>(&_impl_.id_)) + sizeof(_impl_.codec_));
   // @@protoc_insertion_point(copy_constructor:Welcome)
 }
 
@@ -992,6 +1236,7 @@ inline void Welcome::SharedCtor(
   (void)is_message_owned;
   new (&_impl_) Impl_{
       decltype(_impl_.id_){0}
+    , decltype(_impl_.codec_){0}
     , /*decltype(_impl_._cached_size_)*/{}
   };
 }
@@ -1019,7 +1264,9 @@ void Welcome::Clear() {
   // Prevent compiler warnings about cached_has_bits being unused
   (void) cached_has_bits;
 
-  _impl_.id_ = 0;
+  ::memset(&_impl_.id_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&_impl_.codec_) -
+      reinterpret_cast<char*>(&_impl_.id_)) + sizeof(_impl_.codec_));
   _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
@@ -1037,6 +1284,15 @@ const char* Welcome::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx)
         } else
           goto handle_unusual;
         continue;
+      // .PlayerCodec codec = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 16)) {
+          uint64_t val = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+          _internal_set_codec(static_cast<::PlayerCodec>(val));
+        } else
+          goto handle_unusual;
+        continue;
       default:
         goto handle_unusual;
     }  // switch
@@ -1072,6 +1328,13 @@ uint8_t* Welcome::_InternalSerialize(
     target = ::_pbi::WireFormatLite::WriteInt32ToArray(1, this->_internal_id(), target);
   }
 
+  // .PlayerCodec codec = 2;
+  if (this->_internal_codec() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteEnumToArray(
+      2, this->_internal_codec(), target);
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
@@ -1093,6 +1356,12 @@ size_t Welcome::ByteSizeLong() const {
     total_size += ::_pbi::WireFormatLite::Int32SizePlusOne(this->_internal_id());
   }
 
+  // .PlayerCodec codec = 2;
+  if (this->_internal_codec() != 0) {
+    total_size += 1 +
+      ::_pbi::WireFormatLite::EnumSize(this->_internal_codec());
+  }
+
   return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
@@ -1114,6 +1383,9 @@ void Welcome::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOB
   if (from._internal_id() != 0) {
     _this->_internal_set_id(from._internal_id());
   }
+  if (from._internal_codec() != 0) {
+    _this->_internal_set_codec(from._internal_codec());
+  }
   _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
@@ -1131,7 +1403,12 @@ bool Welcome::IsInitialized() const {
 void Welcome::InternalSwap(Welcome* other) {
   using std::swap;
   _internal_metadata_.InternalSwap(&other->_internal_metadata_);
-  swap(_impl_.id_, other->_impl_.id_);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(Welcome, _impl_.codec_)
+      + sizeof(Welcome::_impl_.codec_)
+      - PROTOBUF_FIELD_OFFSET(Welcome, _impl_.id_)>(
+          reinterpret_cast<char*>(&_impl_.id_),
+          reinterpret_cast<char*>(&other->_impl_.id_));
 }
 
 ::PROTOBUF_NAMESPACE_ID::Metadata Welcome::GetMetadata() const {
@@ -1157,14 +1434,29 @@ StatePacket::StatePacket(const StatePacket& from)
   StatePacket* const _this = this; (void)_this;
   new (&_impl_) Impl_{
       decltype(_impl_.players_){from._impl_.players_}
+    , decltype(_impl_.removed_){from._impl_.removed_}
+    , /*decltype(_impl_._removed_cached_byte_size_)*/{0}
+    , decltype(_impl_.packed_players_){}
     , decltype(_impl_.state_){}
     , decltype(_impl_.tick_){}
+    , decltype(_impl_.seq_){}
+    , decltype(_impl_.baseline_seq_){}
+    , decltype(_impl_.part_){}
+    , decltype(_impl_.part_count_){}
     , /*decltype(_impl_._cached_size_)*/{}};
 
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_.packed_players_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.packed_players_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (!from._internal_packed_players().empty()) {
+    _this->_impl_.packed_players_.Set(from._internal_packed_players(), 
+      _this->GetArenaForAllocation());
+  }
   ::memcpy(&_impl_.state_, &from._impl_.state_,
-    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.tick_) -
-    reinterpret_cast<char*>(&_impl_.state_)) + sizeof(_impl_.tick_));
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.part_count_) -
+    reinterpret_cast<char*>(&_impl_.state_)) + sizeof(_impl_.part_count_));
   // @@protoc_insertion_point(copy_constructor:StatePacket)
 }
 
@@ -1174,10 +1466,21 @@ inline void StatePacket::SharedCtor(
   (void)is_message_owned;
   new (&_impl_) Impl_{
       decltype(_impl_.players_){arena}
+    , decltype(_impl_.removed_){arena}
+    , /*decltype(_impl_._removed_cached_byte_size_)*/{0}
+    , decltype(_impl_.packed_players_){}
     , decltype(_impl_.state_){0}
     , decltype(_impl_.tick_){0}
+    , decltype(_impl_.seq_){0u}
+    , decltype(_impl_.baseline_seq_){0u}
+    , decltype(_impl_.part_){0u}
+    , decltype(_impl_.part_count_){0u}
     , /*decltype(_impl_._cached_size_)*/{}
   };
+  _impl_.packed_players_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.packed_players_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
 }
 
 StatePacket::~StatePacket() {
@@ -1192,6 +1495,8 @@ StatePacket::~StatePacket() {
 inline void StatePacket::SharedDtor() {
   GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
   _impl_.players_.~RepeatedPtrField();
+  _impl_.removed_.~RepeatedField();
+  _impl_.packed_players_.Destroy();
 }
 
 void StatePacket::SetCachedSize(int size) const {
@@ -1205,9 +1510,11 @@ void StatePacket::Clear() {
   (void) cached_has_bits;
 
   _impl_.players_.Clear();
+  _impl_.removed_.Clear();
+  _impl_.packed_players_.ClearToEmpty();
   ::memset(&_impl_.state_, 0, static_cast<size_t>(
-      reinterpret_cast<char*>(&_impl_.tick_) -
-      reinterpret_cast<char*>(&_impl_.state_)) + sizeof(_impl_.tick_));
+      reinterpret_cast<char*>(&_impl_.part_count_) -
+      reinterpret_cast<char*>(&_impl_.state_)) + sizeof(_impl_.part_count_));
   _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
@@ -1247,6 +1554,58 @@ const char* StatePacket::_InternalParse(const char* ptr, ::_pbi::ParseContext* c
         } else
           goto handle_unusual;
         continue;
+      // uint32 seq = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 32)) {
+          _impl_.seq_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // uint32 baseline_seq = 5;
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 40)) {
+          _impl_.baseline_seq_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // repeated int32 removed = 6;
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 50)) {
+          ptr = ::PROTOBUF_NAMESPACE_ID::internal::PackedInt32Parser(_internal_mutable_removed(), ptr, ctx);
+          CHK_(ptr);
+        } else if (static_cast<uint8_t>(tag) == 48) {
+          _internal_add_removed(::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr));
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // uint32 part = 7;
+      case 7:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 56)) {
+          _impl_.part_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // uint32 part_count = 8;
+      case 8:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 64)) {
+          _impl_.part_count_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // bytes packed_players = 9;
+      case 9:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 74)) {
+          auto str = _internal_mutable_packed_players();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       default:
         goto handle_unusual;
     }  // switch
@@ -1297,6 +1656,45 @@ uint8_t* StatePacket::_InternalSerialize(
         InternalWriteMessage(3, repfield, repfield.GetCachedSize(), target, stream);
   }
 
+  // uint32 seq = 4;
+  if (this->_internal_seq() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(4, this->_internal_seq(), target);
+  }
+
+  // uint32 baseline_seq = 5;
+  if (this->_internal_baseline_seq() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(5, this->_internal_baseline_seq(), target);
+  }
+
+  // repeated int32 removed = 6;
+  {
+    int byte_size = _impl_._removed_cached_byte_size_.load(std::memory_order_relaxed);
+    if (byte_size > 0) {
+      target = stream->WriteInt32Packed(
+          6, _internal_removed(), byte_size, target);
+    }
+  }
+
+  // uint32 part = 7;
+  if (this->_internal_part() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(7, this->_internal_part(), target);
+  }
+
+  // uint32 part_count = 8;
+  if (this->_internal_part_count() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(8, this->_internal_part_count(), target);
+  }
+
+  // bytes packed_players = 9;
+  if (!this->_internal_packed_players().empty()) {
+    target = stream->WriteBytesMaybeAliased(
+        9, this->_internal_packed_players(), target);
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
@@ -1320,6 +1718,27 @@ size_t StatePacket::ByteSizeLong() const {
       ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(msg);
   }
 
+  // repeated int32 removed = 6;
+  {
+    size_t data_size = ::_pbi::WireFormatLite::
+      Int32Size(this->_impl_.removed_);
+    if (data_size > 0) {
+      total_size += 1 +
+        ::_pbi::WireFormatLite::Int32Size(static_cast<int32_t>(data_size));
+    }
+    int cached_size = ::_pbi::ToCachedSize(data_size);
+    _impl_._removed_cached_byte_size_.store(cached_size,
+                                    std::memory_order_relaxed);
+    total_size += data_size;
+  }
+
+  // bytes packed_players = 9;
+  if (!this->_internal_packed_players().empty()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::BytesSize(
+        this->_internal_packed_players());
+  }
+
   // .GameState state = 1;
   if (this->_internal_state() != 0) {
     total_size += 1 +
@@ -1331,6 +1750,26 @@ size_t StatePacket::ByteSizeLong() const {
     total_size += ::_pbi::WireFormatLite::Int32SizePlusOne(this->_internal_tick());
   }
 
+  // uint32 seq = 4;
+  if (this->_internal_seq() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_seq());
+  }
+
+  // uint32 baseline_seq = 5;
+  if (this->_internal_baseline_seq() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_baseline_seq());
+  }
+
+  // uint32 part = 7;
+  if (this->_internal_part() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_part());
+  }
+
+  // uint32 part_count = 8;
+  if (this->_internal_part_count() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_part_count());
+  }
+
   return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
@@ -1350,12 +1789,28 @@ void StatePacket::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PR
   (void) cached_has_bits;
 
   _this->_impl_.players_.MergeFrom(from._impl_.players_);
+  _this->_impl_.removed_.MergeFrom(from._impl_.removed_);
+  if (!from._internal_packed_players().empty()) {
+    _this->_internal_set_packed_players(from._internal_packed_players());
+  }
   if (from._internal_state() != 0) {
     _this->_internal_set_state(from._internal_state());
   }
   if (from._internal_tick() != 0) {
     _this->_internal_set_tick(from._internal_tick());
   }
+  if (from._internal_seq() != 0) {
+    _this->_internal_set_seq(from._internal_seq());
+  }
+  if (from._internal_baseline_seq() != 0) {
+    _this->_internal_set_baseline_seq(from._internal_baseline_seq());
+  }
+  if (from._internal_part() != 0) {
+    _this->_internal_set_part(from._internal_part());
+  }
+  if (from._internal_part_count() != 0) {
+    _this->_internal_set_part_count(from._internal_part_count());
+  }
   _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
@@ -1372,11 +1827,18 @@ bool StatePacket::IsInitialized() const {
 
 void StatePacket::InternalSwap(StatePacket* other) {
   using std::swap;
+  auto* lhs_arena = GetArenaForAllocation();
+  auto* rhs_arena = other->GetArenaForAllocation();
   _internal_metadata_.InternalSwap(&other->_internal_metadata_);
   _impl_.players_.InternalSwap(&other->_impl_.players_);
+  _impl_.removed_.InternalSwap(&other->_impl_.removed_);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.packed_players_, lhs_arena,
+      &other->_impl_.packed_players_, rhs_arena
+  );
   ::PROTOBUF_NAMESPACE_ID::internal::memswap<
-      PROTOBUF_FIELD_OFFSET(StatePacket, _impl_.tick_)
-      + sizeof(StatePacket::_impl_.tick_)
+      PROTOBUF_FIELD_OFFSET(StatePacket, _impl_.part_count_)
+      + sizeof(StatePacket::_impl_.part_count_)
       - PROTOBUF_FIELD_OFFSET(StatePacket, _impl_.state_)>(
           reinterpret_cast<char*>(&_impl_.state_),
           reinterpret_cast<char*>(&other->_impl_.state_));
@@ -23,7 +23,6 @@
 #include <google/protobuf/io/coded_stream.h>
 #include <google/protobuf/arena.h>
 #include <google/protobuf/arenastring.h>
-#include <google/protobuf/generated_message_bases.h>
 #include <google/protobuf/generated_message_util.h>
 #include <google/protobuf/metadata_lite.h>
 #include <google/protobuf/generated_message_reflection.h>
@@ -104,6 +103,31 @@ inline bool GameState_Parse(
   return ::PROTOBUF_NAMESPACE_ID::internal::ParseNamedEnum<GameState>(
     GameState_descriptor(), name, value);
 }
+enum PlayerCodec : int {
+  PLAYER_CODEC_PROTOBUF = 0,
+  PLAYER_CODEC_PACKED = 1,
+  PlayerCodec_INT_MIN_SENTINEL_DO_NOT_USE_ = std::numeric_limits<int32_t>::min(),
+  PlayerCodec_INT_MAX_SENTINEL_DO_NOT_USE_ = std::numeric_limits<int32_t>::max()
+};
+bool PlayerCodec_IsValid(int value);
+constexpr PlayerCodec PlayerCodec_MIN = PLAYER_CODEC_PROTOBUF;
+constexpr PlayerCodec PlayerCodec_MAX = PLAYER_CODEC_PACKED;
+constexpr int PlayerCodec_ARRAYSIZE = PlayerCodec_MAX + 1;
+
+const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* PlayerCodec_descriptor();
+template<typename T>
+inline const std::string& PlayerCodec_Name(T enum_t_value) {
+  static_assert(::std::is_same<T, PlayerCodec>::value ||
+    ::std::is_integral<T>::value,
+    "Incorrect type passed to function PlayerCodec_Name.");
+  return ::PROTOBUF_NAMESPACE_ID::internal::NameOfEnum(
+    PlayerCodec_descriptor(), enum_t_value);
+}
+inline bool PlayerCodec_Parse(
+    ::PROTOBUF_NAMESPACE_ID::ConstStringParam name, PlayerCodec* value) {
+  return ::PROTOBUF_NAMESPACE_ID::internal::ParseNamedEnum<PlayerCodec>(
+    PlayerCodec_descriptor(), name, value);
+}
 // ===================================================================
 
 class Player final :
@@ -288,9 +312,10 @@ class Player final :
 // -------------------------------------------------------------------
 
 class Hello final :
-    public ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase /* @@protoc_insertion_point(class_definition:Hello) */ {
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:Hello) */ {
  public:
   inline Hello() : Hello(nullptr) {}
+  ~Hello() override;
   explicit PROTOBUF_CONSTEXPR Hello(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
   Hello(const Hello& from);
@@ -363,15 +388,29 @@ class Hello final :
   Hello* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
     return CreateMaybeMessage<Hello>(arena);
   }
-  using ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::CopyFrom;
-  inline void CopyFrom(const Hello& from) {
-    ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::CopyImpl(*this, from);
-  }
-  using ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::MergeFrom;
-  void MergeFrom(const Hello& from) {
-    ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::MergeImpl(*this, from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const Hello& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const Hello& from) {
+    Hello::MergeImpl(*this, from);
   }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
   public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(Hello* other);
 
   private:
   friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
@@ -392,6 +431,18 @@ class Hello final :
 
   // accessors -------------------------------------------------------
 
+  enum : int {
+    kCodecFieldNumber = 1,
+  };
+  // .PlayerCodec codec = 1;
+  void clear_codec();
+  ::PlayerCodec codec() const;
+  void set_codec(::PlayerCodec value);
+  private:
+  ::PlayerCodec _internal_codec() const;
+  void _internal_set_codec(::PlayerCodec value);
+  public:
+
   // @@protoc_insertion_point(class_scope:Hello)
  private:
   class _Internal;
@@ -400,7 +451,10 @@ class Hello final :
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
   struct Impl_ {
+    int codec_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   };
+  union { Impl_ _impl_; };
   friend struct ::TableStruct_game_2eproto;
 };
 // -------------------------------------------------------------------
@@ -527,6 +581,7 @@ class Ping final :
 
   enum : int {
     kIdFieldNumber = 1,
+    kAckSeqFieldNumber = 2,
   };
   // int32 id = 1;
   void clear_id();
@@ -537,6 +592,15 @@ class Ping final :
   void _internal_set_id(int32_t value);
   public:
 
+  // uint32 ack_seq = 2;
+  void clear_ack_seq();
+  uint32_t ack_seq() const;
+  void set_ack_seq(uint32_t value);
+  private:
+  uint32_t _internal_ack_seq() const;
+  void _internal_set_ack_seq(uint32_t value);
+  public:
+
   // @@protoc_insertion_point(class_scope:Ping)
  private:
   class _Internal;
@@ -546,6 +610,7 @@ class Ping final :
   typedef void DestructorSkippable_;
   struct Impl_ {
     int32_t id_;
+    uint32_t ack_seq_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   };
   union { Impl_ _impl_; };
@@ -677,6 +742,7 @@ class ClientUpdate final :
     kIdFieldNumber = 1,
     kXFieldNumber = 2,
     kYFieldNumber = 3,
+    kAckSeqFieldNumber = 4,
   };
   // int32 id = 1;
   void clear_id();
@@ -705,6 +771,15 @@ class ClientUpdate final :
   void _internal_set_y(int32_t value);
   public:
 
+  // uint32 ack_seq = 4;
+  void clear_ack_seq();
+  uint32_t ack_seq() const;
+  void set_ack_seq(uint32_t value);
+  private:
+  uint32_t _internal_ack_seq() const;
+  void _internal_set_ack_seq(uint32_t value);
+  public:
+
   // @@protoc_insertion_point(class_scope:ClientUpdate)
  private:
   class _Internal;
@@ -716,6 +791,7 @@ class ClientUpdate final :
     int32_t id_;
     int32_t x_;
     int32_t y_;
+    uint32_t ack_seq_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   };
   union { Impl_ _impl_; };
@@ -845,6 +921,7 @@ class Welcome final :
 
   enum : int {
     kIdFieldNumber = 1,
+    kCodecFieldNumber = 2,
   };
   // int32 id = 1;
   void clear_id();
@@ -855,6 +932,15 @@ class Welcome final :
   void _internal_set_id(int32_t value);
   public:
 
+  // .PlayerCodec codec = 2;
+  void clear_codec();
+  ::PlayerCodec codec() const;
+  void set_codec(::PlayerCodec value);
+  private:
+  ::PlayerCodec _internal_codec() const;
+  void _internal_set_codec(::PlayerCodec value);
+  public:
+
   // @@protoc_insertion_point(class_scope:Welcome)
  private:
   class _Internal;
@@ -864,6 +950,7 @@ class Welcome final :
   typedef void DestructorSkippable_;
   struct Impl_ {
     int32_t id_;
+    int codec_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   };
   union { Impl_ _impl_; };
@@ -993,8 +1080,14 @@ class StatePacket final :
 
   enum : int {
     kPlayersFieldNumber = 3,
+    kRemovedFieldNumber = 6,
+    kPackedPlayersFieldNumber = 9,
     kStateFieldNumber = 1,
     kTickFieldNumber = 2,
+    kSeqFieldNumber = 4,
+    kBaselineSeqFieldNumber = 5,
+    kPartFieldNumber = 7,
+    kPartCountFieldNumber = 8,
   };
   // repeated .Player players = 3;
   int players_size() const;
@@ -1014,6 +1107,42 @@ class StatePacket final :
   const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::Player >&
       players() const;
 
+  // repeated int32 removed = 6;
+  int removed_size() const;
+  private:
+  int _internal_removed_size() const;
+  public:
+  void clear_removed();
+  private:
+  int32_t _internal_removed(int index) const;
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >&
+      _internal_removed() const;
+  void _internal_add_removed(int32_t value);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >*
+      _internal_mutable_removed();
+  public:
+  int32_t removed(int index) const;
+  void set_removed(int index, int32_t value);
+  void add_removed(int32_t value);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >&
+      removed() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >*
+      mutable_removed();
+
+  // bytes packed_players = 9;
+  void clear_packed_players();
+  const std::string& packed_players() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_packed_players(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_packed_players();
+  PROTOBUF_NODISCARD std::string* release_packed_players();
+  void set_allocated_packed_players(std::string* packed_players);
+  private:
+  const std::string& _internal_packed_players() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_packed_players(const std::string& value);
+  std::string* _internal_mutable_packed_players();
+  public:
+
   // .GameState state = 1;
   void clear_state();
   ::GameState state() const;
@@ -1032,6 +1161,42 @@ class StatePacket final :
   void _internal_set_tick(int32_t value);
   public:
 
+  // uint32 seq = 4;
+  void clear_seq();
+  uint32_t seq() const;
+  void set_seq(uint32_t value);
+  private:
+  uint32_t _internal_seq() const;
+  void _internal_set_seq(uint32_t value);
+  public:
+
+  // uint32 baseline_seq = 5;
+  void clear_baseline_seq();
+  uint32_t baseline_seq() const;
+  void set_baseline_seq(uint32_t value);
+  private:
+  uint32_t _internal_baseline_seq() const;
+  void _internal_set_baseline_seq(uint32_t value);
+  public:
+
+  // uint32 part = 7;
+  void clear_part();
+  uint32_t part() const;
+  void set_part(uint32_t value);
+  private:
+  uint32_t _internal_part() const;
+  void _internal_set_part(uint32_t value);
+  public:
+
+  // uint32 part_count = 8;
+  void clear_part_count();
+  uint32_t part_count() const;
+  void set_part_count(uint32_t value);
+  private:
+  uint32_t _internal_part_count() const;
+  void _internal_set_part_count(uint32_t value);
+  public:
+
   // @@protoc_insertion_point(class_scope:StatePacket)
  private:
   class _Internal;
@@ -1041,8 +1206,15 @@ class StatePacket final :
   typedef void DestructorSkippable_;
   struct Impl_ {
     ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::Player > players_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t > removed_;
+    mutable std::atomic<int> _removed_cached_byte_size_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr packed_players_;
     int state_;
     int32_t tick_;
+    uint32_t seq_;
+    uint32_t baseline_seq_;
+    uint32_t part_;
+    uint32_t part_count_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   };
   union { Impl_ _impl_; };
@@ -1405,6 +1577,26 @@ inline void Player::set_blocked(bool value) {
 
 // Hello
 
+// .PlayerCodec codec = 1;
+inline void Hello::clear_codec() {
+  _impl_.codec_ = 0;
+}
+inline ::PlayerCodec Hello::_internal_codec() const {
+  return static_cast< ::PlayerCodec >(_impl_.codec_);
+}
+inline ::PlayerCodec Hello::codec() const {
+  // @@protoc_insertion_point(field_get:Hello.codec)
+  return _internal_codec();
+}
+inline void Hello::_internal_set_codec(::PlayerCodec value) {
+  
+  _impl_.codec_ = value;
+}
+inline void Hello::set_codec(::PlayerCodec value) {
+  _internal_set_codec(value);
+  // @@protoc_insertion_point(field_set:Hello.codec)
+}
+
 // -------------------------------------------------------------------
 
 // Ping
@@ -1429,6 +1621,26 @@ inline void Ping::set_id(int32_t value) {
   // @@protoc_insertion_point(field_set:Ping.id)
 }
 
+// uint32 ack_seq = 2;
+inline void Ping::clear_ack_seq() {
+  _impl_.ack_seq_ = 0u;
+}
+inline uint32_t Ping::_internal_ack_seq() const {
+  return _impl_.ack_seq_;
+}
+inline uint32_t Ping::ack_seq() const {
+  // @@protoc_insertion_point(field_get:Ping.ack_seq)
+  return _internal_ack_seq();
+}
+inline void Ping::_internal_set_ack_seq(uint32_t value) {
+  
+  _impl_.ack_seq_ = value;
+}
+inline void Ping::set_ack_seq(uint32_t value) {
+  _internal_set_ack_seq(value);
+  // @@protoc_insertion_point(field_set:Ping.ack_seq)
+}
+
 // -------------------------------------------------------------------
 
 // ClientUpdate
@@ -1493,6 +1705,26 @@ inline void ClientUpdate::set_y(int32_t value) {
   // @@protoc_insertion_point(field_set:ClientUpdate.y)
 }
 
+// uint32 ack_seq = 4;
+inline void ClientUpdate::clear_ack_seq() {
+  _impl_.ack_seq_ = 0u;
+}
+inline uint32_t ClientUpdate::_internal_ack_seq() const {
+  return _impl_.ack_seq_;
+}
+inline uint32_t ClientUpdate::ack_seq() const {
+  // @@protoc_insertion_point(field_get:ClientUpdate.ack_seq)
+  return _internal_ack_seq();
+}
+inline void ClientUpdate::_internal_set_ack_seq(uint32_t value) {
+  
+  _impl_.ack_seq_ = value;
+}
+inline void ClientUpdate::set_ack_seq(uint32_t value) {
+  _internal_set_ack_seq(value);
+  // @@protoc_insertion_point(field_set:ClientUpdate.ack_seq)
+}
+
 // -------------------------------------------------------------------
 
 // Welcome
@@ -1517,6 +1749,26 @@ inline void Welcome::set_id(int32_t value) {
   // @@protoc_insertion_point(field_set:Welcome.id)
 }
 
+// .PlayerCodec codec = 2;
+inline void Welcome::clear_codec() {
+  _impl_.codec_ = 0;
+}
+inline ::PlayerCodec Welcome::_internal_codec() const {
+  return static_cast< ::PlayerCodec >(_impl_.codec_);
+}
+inline ::PlayerCodec Welcome::codec() const {
+  // @@protoc_insertion_point(field_get:Welcome.codec)
+  return _internal_codec();
+}
+inline void Welcome::_internal_set_codec(::PlayerCodec value) {
+  
+  _impl_.codec_ = value;
+}
+inline void Welcome::set_codec(::PlayerCodec value) {
+  _internal_set_codec(value);
+  // @@protoc_insertion_point(field_set:Welcome.codec)
+}
+
 // -------------------------------------------------------------------
 
 // StatePacket
@@ -1601,6 +1853,183 @@ StatePacket::players() const {
   return _impl_.players_;
 }
 
+// uint32 seq = 4;
+inline void StatePacket::clear_seq() {
+  _impl_.seq_ = 0u;
+}
+inline uint32_t StatePacket::_internal_seq() const {
+  return _impl_.seq_;
+}
+inline uint32_t StatePacket::seq() const {
+  // @@protoc_insertion_point(field_get:StatePacket.seq)
+  return _internal_seq();
+}
+inline void StatePacket::_internal_set_seq(uint32_t value) {
+  
+  _impl_.seq_ = value;
+}
+inline void StatePacket::set_seq(uint32_t value) {
+  _internal_set_seq(value);
+  // @@protoc_insertion_point(field_set:StatePacket.seq)
+}
+
+// uint32 baseline_seq = 5;
+inline void StatePacket::clear_baseline_seq() {
+  _impl_.baseline_seq_ = 0u;
+}
+inline uint32_t StatePacket::_internal_baseline_seq() const {
+  return _impl_.baseline_seq_;
+}
+inline uint32_t StatePacket::baseline_seq() const {
+  // @@protoc_insertion_point(field_get:StatePacket.baseline_seq)
+  return _internal_baseline_seq();
+}
+inline void StatePacket::_internal_set_baseline_seq(uint32_t value) {
+  
+  _impl_.baseline_seq_ = value;
+}
+inline void StatePacket::set_baseline_seq(uint32_t value) {
+  _internal_set_baseline_seq(value);
+  // @@protoc_insertion_point(field_set:StatePacket.baseline_seq)
+}
+
+// repeated int32 removed = 6;
+inline int StatePacket::_internal_removed_size() const {
+  return _impl_.removed_.size();
+}
+inline int StatePacket::removed_size() const {
+  return _internal_removed_size();
+}
+inline void StatePacket::clear_removed() {
+  _impl_.removed_.Clear();
+}
+inline int32_t StatePacket::_internal_removed(int index) const {
+  return _impl_.removed_.Get(index);
+}
+inline int32_t StatePacket::removed(int index) const {
+  // @@protoc_insertion_point(field_get:StatePacket.removed)
+  return _internal_removed(index);
+}
+inline void StatePacket::set_removed(int index, int32_t value) {
+  _impl_.removed_.Set(index, value);
+  // @@protoc_insertion_point(field_set:StatePacket.removed)
+}
+inline void StatePacket::_internal_add_removed(int32_t value) {
+  _impl_.removed_.Add(value);
+}
+inline void StatePacket::add_removed(int32_t value) {
+  _internal_add_removed(value);
+  // @@protoc_insertion_point(field_add:StatePacket.removed)
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >&
+StatePacket::_internal_removed() const {
+  return _impl_.removed_;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >&
+StatePacket::removed() const {
+  // @@protoc_insertion_point(field_list:StatePacket.removed)
+  return _internal_removed();
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >*
+StatePacket::_internal_mutable_removed() {
+  return &_impl_.removed_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< int32_t >*
+StatePacket::mutable_removed() {
+  // @@protoc_insertion_point(field_mutable_list:StatePacket.removed)
+  return _internal_mutable_removed();
+}
+
+// uint32 part = 7;
+inline void StatePacket::clear_part() {
+  _impl_.part_ = 0u;
+}
+inline uint32_t StatePacket::_internal_part() const {
+  return _impl_.part_;
+}
+inline uint32_t StatePacket::part() const {
+  // @@protoc_insertion_point(field_get:StatePacket.part)
+  return _internal_part();
+}
+inline void StatePacket::_internal_set_part(uint32_t value) {
+  
+  _impl_.part_ = value;
+}
+inline void StatePacket::set_part(uint32_t value) {
+  _internal_set_part(value);
+  // @@protoc_insertion_point(field_set:StatePacket.part)
+}
+
+// uint32 part_count = 8;
+inline void StatePacket::clear_part_count() {
+  _impl_.part_count_ = 0u;
+}
+inline uint32_t StatePacket::_internal_part_count() const {
+  return _impl_.part_count_;
+}
+inline uint32_t StatePacket::part_count() const {
+  // @@protoc_insertion_point(field_get:StatePacket.part_count)
+  return _internal_part_count();
+}
+inline void StatePacket::_internal_set_part_count(uint32_t value) {
+  
+  _impl_.part_count_ = value;
+}
+inline void StatePacket::set_part_count(uint32_t value) {
+  _internal_set_part_count(value);
+  // @@protoc_insertion_point(field_set:StatePacket.part_count)
+}
+
+// bytes packed_players = 9;
+inline void StatePacket::clear_packed_players() {
+  _impl_.packed_players_.ClearToEmpty();
+}
+inline const std::string& StatePacket::packed_players() const {
+  // @@protoc_insertion_point(field_get:StatePacket.packed_players)
+  return _internal_packed_players();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void StatePacket::set_packed_players(ArgT0&& arg0, ArgT... args) {
+ 
+ _impl_.packed_players_.SetBytes(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:StatePacket.packed_players)
+}
+inline std::string* StatePacket::mutable_packed_players() {
+  std::string* _s = _internal_mutable_packed_players();
+  // @@protoc_insertion_point(field_mutable:StatePacket.packed_players)
+  return _s;
+}
+inline const std::string& StatePacket::_internal_packed_players() const {
+  return _impl_.packed_players_.Get();
+}
+inline void StatePacket::_internal_set_packed_players(const std::string& value) {
+  
+  _impl_.packed_players_.Set(value, GetArenaForAllocation());
+}
+inline std::string* StatePacket::_internal_mutable_packed_players() {
+  
+  return _impl_.packed_players_.Mutable(GetArenaForAllocation());
+}
+inline std::string* StatePacket::release_packed_players() {
+  // @@protoc_insertion_point(field_release:StatePacket.packed_players)
+  return _impl_.packed_players_.Release();
+}
+inline void StatePacket::set_allocated_packed_players(std::string* packed_players) {
+  if (packed_players != nullptr) {
+    
+  } else {
+    
+  }
+  _impl_.packed_players_.SetAllocated(packed_players, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.packed_players_.IsDefault()) {
+    _impl_.packed_players_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:StatePacket.packed_players)
+}
+
 // -------------------------------------------------------------------
 
 // Packet
@@ -2010,6 +2439,11 @@ template <>
 inline const EnumDescriptor* GetEnumDescriptor< ::GameState>() {
   return ::GameState_descriptor();
 }
+template <> struct is_proto_enum< ::PlayerCodec> : ::std::true_type {};
+template <>
+inline const EnumDescriptor* GetEnumDescriptor< ::PlayerCodec>() {
+  return ::PlayerCodec_descriptor();
+}
 
 PROTOBUF_NAMESPACE_CLOSE
 
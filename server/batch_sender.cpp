@@ -0,0 +1,329 @@
+#include "batch_sender.h"
+#include "uring.h"
+#include <algorithm>
+#include <iostream>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <climits>
+#include <tuple>
+#include <poll.h>
+#include <netinet/udp.h>
+
+constexpr int EAGAIN_RETRIES = 3;       ///< Waits for POLLOUT before dropping the rest of a flush
+constexpr int EAGAIN_WAIT_MS = 2;       ///< Max wait per retry, keeps a full buffer from stalling the tick
+constexpr size_t GSO_MAX_SEGMENTS = 64; ///< Kernel limit on segments per GSO send (UDP_MAX_SEGMENTS)
+constexpr size_t GSO_MAX_BYTES = 65000; ///< Stay below the 64 KiB UDP payload limit per GSO send
+
+#ifndef UIO_MAXIOV
+#define UIO_MAXIOV 1024
+#endif
+
+bool parseSendMode(const std::string& name, SendMode& mode) {
+    if (name == "plain") { mode = SendMode::Plain; return true; }
+    if (name == "batch") { mode = SendMode::Batched; return true; }
+    if (name == "gso") { mode = SendMode::Gso; return true; }
+    if (name == "uring") { mode = SendMode::Uring; return true; }
+    return false;
+}
+
+const char* sendModeName(SendMode mode) {
+    switch (mode) {
+        case SendMode::Plain: return "plain";
+        case SendMode::Batched: return "batch";
+        case SendMode::Gso: return "gso";
+        case SendMode::Uring: return "uring";
+    }
+    return "unknown";
+}
+
+BatchSender::BatchSender(size_t expected_destinations) {
+    ensureCapacity(expected_destinations);
+}
+
+BatchSender::~BatchSender() = default;
+
+SendMode BatchSender::setMode(SendMode requested, int sockfd) {
+    mode = requested;
+    if (mode == SendMode::Gso) {
+        int value = 0;
+        socklen_t len = sizeof(value);
+        if (getsockopt(sockfd, SOL_UDP, UDP_SEGMENT, &value, &len) < 0) {
+            std::cout << "[WARN] UDP GSO not supported by kernel, using batched sends" << std::endl;
+            mode = SendMode::Batched;
+        }
+    } else if (mode == SendMode::Uring && !uring) {
+        auto ring = std::make_unique<UringRing>();
+        if (ring->init(UIO_MAXIOV) && ring->registerFile(sockfd)) {
+            uring = std::move(ring);
+        } else {
+            std::cout << "[WARN] io_uring unavailable, using batched sends" << std::endl;
+            mode = SendMode::Batched;
+        }
+    }
+    return mode;
+}
+
+void BatchSender::ensureCapacity(size_t n) {
+    if (n <= msgs.size()) return;
+    addrs.resize(n);
+    iovecs.resize(n);
+    segments.resize(n);
+    controls.resize(n);
+    msgs.resize(n);
+}
+
+void BatchSender::push(const sockaddr_in& addr, const void* data, size_t len, uint16_t segment_size) {
+    if (count == msgs.size()) {
+        ensureCapacity(std::max<size_t>(64, msgs.size() * 2));
+    }
+    addrs[count] = addr;
+    iovecs[count].iov_base = const_cast<void*>(data);
+    iovecs[count].iov_len = len;
+    segments[count] = segment_size;
+    count++;
+}
+
+void BatchSender::queue(const sockaddr_in& addr, const void* data, size_t len) {
+    push(addr, data, len, 0);
+}
+
+void BatchSender::queueSegmented(const sockaddr_in& addr, const void* data, size_t len, size_t segment_size) {
+    const char* bytes = static_cast<const char*>(data);
+
+    if (mode != SendMode::Gso || segment_size == 0 || len <= segment_size) {
+        size_t step = segment_size ? segment_size : len;
+        for (size_t off = 0; off < len; off += step) {
+            push(addr, bytes + off, std::min(step, len - off), 0);
+        }
+        return;
+    }
+
+    size_t per_send = std::min(GSO_MAX_SEGMENTS, GSO_MAX_BYTES / segment_size) * segment_size;
+    for (size_t off = 0; off < len; off += per_send) {
+        size_t chunk = std::min(per_send, len - off);
+        push(addr, bytes + off, chunk, chunk > segment_size ? static_cast<uint16_t>(segment_size) : 0);
+    }
+}
+
+size_t BatchSender::segmentsOf(size_t i) const {
+    if (segments[i] == 0) return 1;
+    return (iovecs[i].iov_len + segments[i] - 1) / segments[i];
+}
+
+size_t BatchSender::flush(int sockfd) {
+    size_t sent;
+    switch (mode) {
+        case SendMode::Plain: sent = flushPlain(sockfd); break;
+        case SendMode::Uring: sent = flushUring(sockfd); break;
+        default: sent = flushBatched(sockfd); break;
+    }
+    count = 0;
+    return sent;
+}
+
+size_t BatchSender::flushPlain(int sockfd) {
+    size_t sent = 0;
+    for (size_t i = 0; i < count; ++i) {
+        ssize_t n;
+        do {
+            n = sendto(sockfd, iovecs[i].iov_base, iovecs[i].iov_len, 0,
+                       (const sockaddr*)&addrs[i], sizeof(addrs[i]));
+            tickStats.syscalls++;
+        } while (n < 0 && errno == EINTR);
+
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) tickStats.eagain++;
+            tickStats.dropped++;
+            continue;
+        }
+        tickStats.datagrams++;
+        tickStats.bytes += iovecs[i].iov_len;
+        sent++;
+    }
+    return sent;
+}
+
+void BatchSender::prepareHeaders() {
+    for (size_t i = 0; i < count; ++i) {
+        msghdr& hdr = msgs[i].msg_hdr;
+        std::memset(&hdr, 0, sizeof(hdr));
+        hdr.msg_name = &addrs[i];
+        hdr.msg_namelen = sizeof(sockaddr_in);
+        hdr.msg_iov = &iovecs[i];
+        hdr.msg_iovlen = 1;
+
+        if (segments[i] != 0) {
+            hdr.msg_control = controls[i].buf;
+            hdr.msg_controllen = CMSG_SPACE(sizeof(uint16_t));
+            cmsghdr* cm = CMSG_FIRSTHDR(&hdr);
+            cm->cmsg_level = SOL_UDP;
+            cm->cmsg_type = UDP_SEGMENT;
+            cm->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+            std::memcpy(CMSG_DATA(cm), &segments[i], sizeof(uint16_t));
+        }
+    }
+}
+
+void BatchSender::fallBackFromGso(size_t from) {
+    std::cout << "[WARN] Kernel rejected UDP GSO send, falling back to batched sends" << std::endl;
+    mode = SendMode::Batched;
+
+    std::vector<std::tuple<sockaddr_in, const void*, size_t, uint16_t>> rest;
+    for (size_t i = from; i < count; ++i) {
+        rest.emplace_back(addrs[i], iovecs[i].iov_base, iovecs[i].iov_len, segments[i]);
+    }
+    count = from;
+    for (const auto& [addr, data, len, seg] : rest) {
+        queueSegmented(addr, data, len, seg);
+    }
+}
+
+size_t BatchSender::flushBatched(int sockfd) {
+    // Pointers into the vectors are only stable once queueing is done.
+    prepareHeaders();
+
+    size_t sent = 0;
+    size_t next = 0;
+    int retries = 0;
+
+    while (next < count) {
+        unsigned int chunk = static_cast<unsigned int>(std::min<size_t>(count - next, UIO_MAXIOV));
+        int n = sendmmsg(sockfd, &msgs[next], chunk, 0);
+        tickStats.syscalls++;
+
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                tickStats.eagain++;
+                if (retries++ < EAGAIN_RETRIES) {
+                    pollfd pfd{sockfd, POLLOUT, 0};
+                    poll(&pfd, 1, EAGAIN_WAIT_MS);
+                    continue;
+                }
+                // Socket is persistently full; drop the remainder of this tick.
+                for (size_t i = next; i < count; ++i) tickStats.dropped += segmentsOf(i);
+                break;
+            }
+            if (segments[next] != 0 && (errno == EIO || errno == EINVAL || errno == EOPNOTSUPP ||
+                                        errno == ENOPROTOOPT)) {
+                // GSO refused (e.g. no checksum offload on the route): split and retry.
+                fallBackFromGso(next);
+                prepareHeaders();
+                continue;
+            }
+            // Error specific to the message at `next` (e.g. unreachable destination): skip it.
+            perror("sendmmsg failed");
+            tickStats.dropped += segmentsOf(next);
+            next++;
+            continue;
+        }
+
+        if (static_cast<unsigned int>(n) < chunk) {
+            tickStats.partial++;
+        }
+        for (int i = 0; i < n; ++i) {
+            tickStats.bytes += iovecs[next + i].iov_len;
+            tickStats.datagrams += segmentsOf(next + i);
+            sent += segmentsOf(next + i);
+        }
+        next += n;
+        retries = 0;
+    }
+
+    return sent;
+}
+
+size_t BatchSender::flushUring(int sockfd) {
+    prepareHeaders();
+
+    uringPending.clear();
+    for (size_t i = 0; i < count; ++i) {
+        uringPending.push_back(static_cast<uint32_t>(i));
+    }
+
+    size_t sent = 0;
+    int retries = 0;
+
+    while (!uringPending.empty()) {
+        uringRetry.clear();
+
+        for (size_t start = 0; start < uringPending.size(); ) {
+            unsigned queued = 0;
+            while (start + queued < uringPending.size()) {
+                io_uring_sqe* sqe = uring->getSqe();
+                if (!sqe) break;
+                uint32_t idx = uringPending[start + queued];
+                sqe->opcode = IORING_OP_SENDMSG;
+                sqe->fd = 0;                      // fixed file index
+                sqe->flags = IOSQE_FIXED_FILE;
+                sqe->addr = reinterpret_cast<uint64_t>(&msgs[idx].msg_hdr);
+                sqe->len = 1;
+                sqe->user_data = idx;
+                queued++;
+            }
+
+            int ret = uring->submit(queued);
+            tickStats.syscalls++;
+            if (ret < 0) {
+                std::cerr << "[WARN] io_uring submit failed: " << strerror(-ret) << std::endl;
+                tickStats.dropped += uringPending.size() - start;
+                return sent;
+            }
+
+            // Every submitted SENDMSG must complete before its header or payload is reused.
+            unsigned done = 0;
+            while (done < queued) {
+                done += uring->forEachCqe([&](const io_uring_cqe& cqe) {
+                    uint32_t idx = static_cast<uint32_t>(cqe.user_data);
+                    if (cqe.res >= 0) {
+                        tickStats.datagrams++;
+                        tickStats.bytes += iovecs[idx].iov_len;
+                        sent++;
+                    } else if (cqe.res == -EAGAIN) {
+                        tickStats.eagain++;
+                        uringRetry.push_back(idx);
+                    } else {
+                        tickStats.dropped++;
+                    }
+                });
+                if (done < queued) {
+                    uring->submit(queued - done);
+                    tickStats.syscalls++;
+                }
+            }
+            start += queued;
+        }
+
+        if (uringRetry.empty()) break;
+        if (retries++ >= EAGAIN_RETRIES) {
+            tickStats.dropped += uringRetry.size();
+            break;
+        }
+        pollfd pfd{sockfd, POLLOUT, 0};
+        poll(&pfd, 1, EAGAIN_WAIT_MS);
+        uringPending.swap(uringRetry);
+    }
+
+    return sent;
+}
+
+void BatchSender::beginTick() {
+    totalStats.add(tickStats);
+    tickStats = SendStats{};
+}
+
+void BatchSender::logAndResetStats() {
+    if (totalStats.syscalls == 0 && tickStats.syscalls == 0) return;
+
+    std::cout << "[STATS] send (" << sendModeName(mode) << ") tick: sent=" << tickStats.datagrams
+              << " syscalls=" << tickStats.syscalls
+              << " bytes=" << tickStats.bytes
+              << " | total: sent=" << totalStats.datagrams
+              << " syscalls=" << totalStats.syscalls
+              << " partial=" << totalStats.partial
+              << " eagain=" << totalStats.eagain
+              << " dropped=" << totalStats.dropped << std::endl;
+
+    resetTotals();
+}
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+class UringRing;
+
+/**
+ * @brief How BatchSender hands datagrams to the kernel.
+ */
+enum class SendMode {
+    Plain,    ///< One sendto() per datagram (reference path)
+    Batched,  ///< sendmmsg() over all queued datagrams
+    Gso,      ///< sendmmsg() with UDP_SEGMENT, one message per destination burst
+    Uring     ///< io_uring SENDMSG submissions, one io_uring_enter() per SQ-sized batch
+};
+
+/**
+ * @brief Parses "plain", "batch", "gso" or "uring" into a SendMode.
+ * @return false if the name is not recognised.
+ */
+bool parseSendMode(const std::string& name, SendMode& mode);
+
+/**
+ * @brief Human-readable name of a SendMode (matches parseSendMode()).
+ */
+const char* sendModeName(SendMode mode);
+
+/**
+ * @brief Send counters kept by BatchSender.
+ */
+struct SendStats {
+    uint64_t datagrams = 0;   ///< Datagrams accepted by the kernel (GSO segments counted individually)
+    uint64_t bytes = 0;       ///< Payload bytes accepted by the kernel
+    uint64_t syscalls = 0;    ///< sendto()/sendmmsg()/io_uring_enter() calls issued
+    uint64_t partial = 0;     ///< Calls that sent fewer messages than requested
+    uint64_t eagain = 0;      ///< Times the socket buffer was full (EAGAIN)
+    uint64_t dropped = 0;     ///< Datagrams given up on after errors or retries
+
+    void add(const SendStats& other) {
+        datagrams += other.datagrams;
+        bytes += other.bytes;
+        syscalls += other.syscalls;
+        partial += other.partial;
+        eagain += other.eagain;
+        dropped += other.dropped;
+    }
+};
+
+/**
+ * @brief Queues outgoing datagrams and flushes them with sendmmsg().
+ *
+ * Datagrams are described by `mmsghdr` entries that point at caller-owned
+ * payloads, so the payload must stay alive until `flush()` returns. The
+ * queue grows to the largest fan-out seen and is then reused, so a steady
+ * broadcast does not allocate. A flush submits at most UIO_MAXIOV messages
+ * per syscall, resumes after partial sends, and waits briefly for the
+ * socket to drain when the kernel reports EAGAIN.
+ *
+ * In SendMode::Gso, a burst of equal-sized datagrams to one destination
+ * (see queueSegmented()) travels as a single message carrying a
+ * UDP_SEGMENT control header, and the kernel splits it. GSO cannot fan one
+ * payload out to different addresses, so single-datagram destinations are
+ * sent exactly as in SendMode::Batched. If the kernel rejects GSO at
+ * runtime the sender falls back to SendMode::Batched and re-sends.
+ *
+ * In SendMode::Uring the prepared message headers are submitted as
+ * IORING_OP_SENDMSG requests on a private ring with the socket registered
+ * as a fixed file; each submission waits for its completions so payloads
+ * can be reused as soon as flush() returns.
+ */
+class BatchSender {
+public:
+    /**
+     * @param expected_destinations Queue capacity to preallocate.
+     */
+    explicit BatchSender(size_t expected_destinations = 0);
+    ~BatchSender();
+
+    BatchSender(const BatchSender&) = delete;
+    BatchSender& operator=(const BatchSender&) = delete;
+
+    /**
+     * @brief Selects the send mode.
+     *
+     * Requesting SendMode::Gso on a socket whose kernel lacks UDP_SEGMENT
+     * support, or SendMode::Uring when io_uring cannot be set up, selects
+     * SendMode::Batched instead.
+     *
+     * @param mode Requested mode.
+     * @param sockfd Socket used to probe for GSO support.
+     * @return The mode actually in effect.
+     */
+    SendMode setMode(SendMode mode, int sockfd);
+
+    SendMode getMode() const { return mode; }
+
+    /**
+     * @brief Queues one datagram for the next flush.
+     *
+     * @param addr Destination address.
+     * @param data Payload; must remain valid until flush() returns.
+     * @param len Payload length in bytes.
+     */
+    void queue(const sockaddr_in& addr, const void* data, size_t len);
+
+    /**
+     * @brief Queues a run of datagrams of `segment_size` bytes (the last may be shorter).
+     *
+     * In GSO mode the run is one message per 64 segments; otherwise it is
+     * split into individual datagrams at queue time.
+     *
+     * @param addr Destination address.
+     * @param data Concatenated segments; must remain valid until flush() returns.
+     * @param len Total length in bytes.
+     * @param segment_size Size of every segment but the last.
+     */
+    void queueSegmented(const sockaddr_in& addr, const void* data, size_t len, size_t segment_size);
+
+    /**
+     * @brief Sends every queued datagram and clears the queue.
+     *
+     * @param sockfd UDP socket to send with (may be non-blocking).
+     * @return Number of datagrams the kernel accepted.
+     */
+    size_t flush(int sockfd);
+
+    /**
+     * @brief Number of messages waiting for the next flush.
+     */
+    size_t pending() const { return count; }
+
+    /**
+     * @brief Starts a new tick: moves the current tick counters into the totals.
+     */
+    void beginTick();
+
+    /**
+     * @brief Counters for the current (or just finished) tick.
+     */
+    const SendStats& getTickStats() const { return tickStats; }
+
+    /**
+     * @brief Counters accumulated since the last resetTotals(), excluding the current tick.
+     */
+    const SendStats& getTotalStats() const { return totalStats; }
+
+    /**
+     * @brief Clears the accumulated totals.
+     */
+    void resetTotals() { totalStats = SendStats{}; }
+
+    /**
+     * @brief Prints the last tick's counters and the totals, then resets the totals.
+     */
+    void logAndResetStats();
+
+private:
+    /// Room for one UDP_SEGMENT control message per queued entry.
+    struct alignas(cmsghdr) GsoControl {
+        char buf[CMSG_SPACE(sizeof(uint16_t))];
+    };
+
+    void ensureCapacity(size_t n);
+    void push(const sockaddr_in& addr, const void* data, size_t len, uint16_t segment_size);
+    void prepareHeaders();
+    size_t flushPlain(int sockfd);
+    size_t flushBatched(int sockfd);
+    size_t flushUring(int sockfd);
+    void fallBackFromGso(size_t from);
+    size_t segmentsOf(size_t i) const;
+
+    SendMode mode = SendMode::Batched;
+    size_t count = 0;                   ///< Queued messages
+    std::vector<sockaddr_in> addrs;     ///< Destination per queued message
+    std::vector<iovec> iovecs;          ///< Payload per queued message
+    std::vector<uint16_t> segments;     ///< GSO segment size per message (0 = plain datagram)
+    std::vector<GsoControl> controls;   ///< UDP_SEGMENT cmsg storage per message
+    std::vector<mmsghdr> msgs;          ///< sendmmsg() descriptors
+    std::unique_ptr<UringRing> uring;   ///< Send ring for SendMode::Uring
+    std::vector<uint32_t> uringPending; ///< Message indices still to submit (reused)
+    std::vector<uint32_t> uringRetry;   ///< Message indices that hit EAGAIN (reused)
+    SendStats tickStats;
+    SendStats totalStats;
+};
@@ -0,0 +1,63 @@
+#include "broadcast_worker.h"
+#include "../common/config.h"
+#include <iostream>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+BroadcastWorker::BroadcastWorker(GameManager& game, Transport& transport)
+    : game(game),
+      transport(transport) {
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    stopFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeFd < 0 || stopFd < 0) {
+        perror("eventfd failed");
+    }
+}
+
+BroadcastWorker::~BroadcastWorker() {
+    stop();
+    if (wakeFd >= 0) close(wakeFd);
+    if (stopFd >= 0) close(stopFd);
+}
+
+void BroadcastWorker::start() {
+    loop.addReader(wakeFd, [this](uint32_t) { onWake(); });
+    loop.addReader(stopFd, [this](uint32_t) { loop.stop(); });
+    loop.addTimer(STATS_LOG_INTERVAL_SEC * 1000, [this](uint64_t) {
+        transport.logAndResetStats();
+        game.logAndResetBroadcastStats();
+        uint64_t skipped = game.getSkippedSnapshots();
+        if (skipped != lastSkipped) {
+            std::cout << "[STATS] broadcast skipped_snapshots=" << (skipped - lastSkipped) << std::endl;
+            lastSkipped = skipped;
+        }
+    });
+    thread = std::thread([this]() { run(); });
+}
+
+void BroadcastWorker::stop() {
+    if (!thread.joinable()) return;
+    uint64_t one = 1;
+    if (write(stopFd, &one, sizeof(one)) < 0) {
+        perror("eventfd write failed");
+    }
+    thread.join();
+}
+
+void BroadcastWorker::wake() {
+    uint64_t one = 1;
+    if (write(wakeFd, &one, sizeof(one)) < 0 && errno != EAGAIN) {
+        perror("eventfd write failed");
+    }
+}
+
+void BroadcastWorker::run() {
+    loop.run();
+}
+
+void BroadcastWorker::onWake() {
+    uint64_t count;
+    if (read(wakeFd, &count, sizeof(count)) < 0) return;
+    game.broadcastToAll();
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <thread>
+#include "event_loop.h"
+#include "game_manager.h"
+#include "transport.h"
+
+/**
+ * @brief Broadcast thread that encodes and sends published world snapshots.
+ *
+ * The simulation thread calls wake() after each tick; the worker then runs
+ * GameManager::broadcastToAll(), which reads only the latest snapshot, so
+ * serialization and the send syscalls stay off the tick thread. Wakeups
+ * coalesce: if several ticks publish while a broadcast is in flight, only
+ * the newest snapshot is sent.
+ */
+class BroadcastWorker {
+public:
+    /**
+     * @param game Source of snapshots; must outlive the worker.
+     * @param transport Transport used for broadcasts (its stats are logged here).
+     */
+    BroadcastWorker(GameManager& game, Transport& transport);
+    ~BroadcastWorker();
+
+    BroadcastWorker(const BroadcastWorker&) = delete;
+    BroadcastWorker& operator=(const BroadcastWorker&) = delete;
+
+    /**
+     * @brief Starts the worker thread.
+     */
+    void start();
+
+    /**
+     * @brief Stops the worker thread and waits for it to exit.
+     */
+    void stop();
+
+    /**
+     * @brief Signals that a new snapshot was published (any thread).
+     */
+    void wake();
+
+private:
+    void run();
+    void onWake();
+
+    GameManager& game;
+    Transport& transport;
+    int wakeFd = -1;                      ///< Simulation -> broadcast "snapshot ready"
+    int stopFd = -1;                      ///< Simulation -> broadcast shutdown request
+    EventLoop loop;
+    uint64_t lastSkipped = 0;             ///< Skipped-snapshot count at the last stats line
+
+    std::thread thread;
+};
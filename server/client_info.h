@@ -1,50 +1,34 @@
 #pragma once
 
-#include <string>
-#include <chrono>
 #include <netinet/in.h>  // for sockaddr_in
+#include "utils.h"       // for EndpointKey
+#include "../generated/game.pb.h"
 
 /**
- * @brief Represents a single connected client in the multiplayer system.
+ * @brief Cold, per-connection data of a single connected client.
  *
- * The server uses this struct to store connection-specific data such as
- * assigned ID, IP address and port, current position, and last activity timestamp.
- * This enables tracking client sessions and maintaining synchronized game state.
+ * Only needed when sending to the client or matching an incoming packet to
+ * it. The per-tick fields (position, blocked flag, last activity) live in
+ * PlayerStore's columns so tick passes do not drag these bytes through the
+ * cache.
  */
 struct Client {
     /**
-     * @brief Unique ID assigned by the server to identify the client.
+     * @brief Packed IP and port (used for identification and table lookup).
      *
-     * This integer ID is used in protocol messages and state broadcasting.
+     * Use formatSockAddr(addr) for the printable "127.0.0.1:54321" form.
      */
-    int id;
-
-    /**
-     * @brief IP and port string key (used for identification and map lookup).
-     *
-     * Format: "127.0.0.1:54321"
-     */
-    std::string ip_port;
+    EndpointKey key = 0;
 
     /**
      * @brief Raw socket address of the client, used for sending messages back.
      *
      * Required for use in `sendto()`. This is set when the server first receives a packet.
      */
-    sockaddr_in addr;
+    sockaddr_in addr{};
 
     /**
-     * @brief Most recent position update from the client.
-     */
-    int x = 0;
-    int y = 0;
-
-    bool blocked = false;  ///< Indicates if the client is currently blocked (e.g., due to collision)
-
-    /**
-     * @brief Timestamp of the last received packet from this client.
-     *
-     * Used to detect inactive or disconnected clients based on elapsed time.
+     * @brief Snapshot encoding negotiated in the HELLO / WELCOME handshake.
      */
-    std::chrono::steady_clock::time_point last_seen;
+    PlayerCodec codec = PLAYER_CODEC_PROTOBUF;
 };
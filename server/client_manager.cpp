@@ -7,107 +7,115 @@
 #include <unistd.h>
 #include <chrono>
 #include <cstring>
-#include <cmath>
+#include <cstdint>
+#include <stdexcept>
 
-int ClientManager::registerClient(const sockaddr_in& addr) {
-    std::string key = getClientKey(addr);
-    if (clients.find(key) != clients.end()) {
-        return clients[key].id; // Already registered
+static_assert(COLLISION_CELL_SIZE >= MIN_PLAYER_DISTANCE,
+              "collision queries only scan the 3x3 neighbouring cells");
+
+ClientManager::ClientManager(CollisionEngineType engine)
+    : collision(makeCollisionEngine(engine)) {}
+
+int ClientManager::registerClient(const sockaddr_in& addr, PlayerCodec codec) {
+    EndpointKey key = getClientKey(addr);
+    int existing = endpoints.find(key);
+    if (existing > 0) {
+        return existing; // Already registered
     }
 
     Client c;
-    c.id = nextClientId++;
-    c.ip_port = key;
+    c.key = key;
     c.addr = addr;
-    c.last_seen = std::chrono::steady_clock::now();
-    clients[key] = c;
-
-    return c.id;
-}
+    c.codec = codec;
+    int id = players.add(c, std::chrono::steady_clock::now());
+    if (id < 0) return -1; // Every slot in use
 
-bool ClientManager::isKnown(const std::string& ip_port) const {
-    return clients.find(ip_port) != clients.end();
+    endpoints.insert(key, id);
+    collision->insert(id, 0, 0);
+    return id;
 }
 
-Client& ClientManager::getClient(const std::string& ip_port) {
-    return clients.at(ip_port);
+bool ClientManager::isKnown(EndpointKey key) const {
+    return endpoints.find(key) > 0;
 }
 
-std::string ClientManager::getClientKey(const sockaddr_in& addr) const {
-    return formatSockAddr(addr);
+const Client& ClientManager::getClient(EndpointKey key) const {
+    int row = players.rowOf(endpoints.find(key));
+    if (row < 0) throw std::out_of_range("unknown client " + std::to_string(key));
+    return players.getInfo()[row];
 }
 
-
-bool ClientManager::validateClient(int id, const std::string& ip_port) {
-    auto it = clients.find(ip_port);
-    return it != clients.end() && it->second.id == id;
+bool ClientManager::validateClient(int id, EndpointKey key) const {
+    // Stale IDs fail the slot's generation check inside rowOf().
+    int row = players.rowOf(id);
+    return row >= 0 && players.getInfo()[row].key == key;
 }
 
 void ClientManager::updateClientPosition(int id, int x, int y) {
-    // @todo: replace with a more efficient search if needed
-    // This is a linear search, but for small client counts it should be fine.
-    for (auto& [key, client] : clients) {
-        if (client.id == id) {
-            client.x = x;
-            client.y = y;
-            client.last_seen = std::chrono::steady_clock::now();
-            return;
-        }
+    int row = players.rowOf(id);
+    if (row >= 0) {
+        players.setPosition(row, x, y);
+        collision->move(id, x, y);
+        players.setLastSeen(row, std::chrono::steady_clock::now());
     }
 }
 
-void ClientManager::markSeen(const std::string& ip_port) {
-    if (isKnown(ip_port)) {
-        clients[ip_port].last_seen = std::chrono::steady_clock::now();
+void ClientManager::acknowledge(int id, uint32_t seq) {
+    int row = players.rowOf(id);
+    if (row >= 0 && seq != 0) {
+        players.setAcked(row, seq);
     }
 }
 
-void ClientManager::broadcastBinary(int sockfd, const std::string& data) const {
-    for (const auto& [_, client] : clients) {
-        sendto(sockfd, data.data(), data.size(), 0,
-               (const struct sockaddr*)&client.addr, sizeof(client.addr));
+void ClientManager::markSeen(EndpointKey key) {
+    int row = players.rowOf(endpoints.find(key));
+    if (row >= 0) {
+        players.setLastSeen(row, std::chrono::steady_clock::now());
     }
 }
 
-
 bool ClientManager::isCollisionFree(int x, int y, int my_id, int min_distance) const {
-    for (const auto& [_, client] : clients) {
-        if (client.id == my_id) continue;
-        int dx = client.x - x;
-        int dy = client.y - y;
-        double distance = std::sqrt(dx * dx + dy * dy);
-        if (distance < min_distance) return false;
+    if (min_distance <= collision->getMaxRadius()) {
+        return !collision->anyWithin(x, y, min_distance, my_id);
+    }
+
+    const int* ids = players.getIds().data();
+    const int* xs = players.getX().data();
+    const int* ys = players.getY().data();
+    const int64_t limit = static_cast<int64_t>(min_distance) * min_distance;
+    for (size_t i = 0, n = players.size(); i < n; ++i) {
+        int64_t dx = static_cast<int64_t>(xs[i]) - x;
+        int64_t dy = static_cast<int64_t>(ys[i]) - y;
+        // Compare squared distances; same result as sqrt(..) < min_distance.
+        if (dx * dx + dy * dy < limit && ids[i] != my_id) return false;
     }
     return true;
 }
 
 
 void ClientManager::setBlocked(int id, bool status) {
-    for (auto& [_, client] : clients) {
-        if (client.id == id) {
-            client.blocked = status;
-            break;
-        }
+    int row = players.rowOf(id);
+    if (row >= 0) {
+        players.setBlocked(row, status);
     }
 }
 
-std::unordered_map<std::string, Client>& ClientManager::getClientsMutable() {
-    return clients;
-}
-
 
 
 
 void ClientManager::pruneInactiveClients() {
     auto now = std::chrono::steady_clock::now();
-    for (auto it = clients.begin(); it != clients.end(); ) {
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
-            now - it->second.last_seen);
-        if (duration.count() > CLIENT_TIMEOUT_MS) {
-            std::cout << "[INFO] Dropping inactive client " << it->second.id << std::endl;
-            it = clients.erase(it);
-        } else {
-            ++it;
-        }
+    const auto deadline = now - std::chrono::milliseconds(CLIENT_TIMEOUT_MS);
+    const auto& last_seen = players.getLastSeen();
+    // Collect first: removal moves rows around.
+    std::vector<int> expired;
+    for (size_t i = 0, n = players.size(); i < n; ++i) {
+        if (last_seen[i] < deadline) expired.push_back(players.getIds()[i]);
+    }
+    for (int id : expired) {
+        std::cout << "[INFO] Dropping inactive client " << id << std::endl;
+        endpoints.erase(players.getInfo()[players.rowOf(id)].key);
+        players.remove(id);
+        collision->remove(id);
     }
 }
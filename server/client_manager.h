@@ -1,52 +1,74 @@
 #pragma once
 
-#include <unordered_map>
-#include <string>
 #include <netinet/in.h>
 #include "client_info.h"
+#include "endpoint_table.h"
+#include "player_store.h"
+#include "collision_engine.h"
+#include <memory>
 
 /**
  * @brief Manages all connected clients for the multiplayer server.
  * 
  * Tracks client registrations, validates incoming updates, and builds
  * state packets for broadcasting. Clients are uniquely identified by
- * their IP:Port string and assigned a numeric ID on registration.
+ * their packed IP:Port (EndpointKey) and assigned a numeric ID on registration.
+ * The ID is a SlotMap handle (slot index plus generation), so lookups by ID
+ * are O(1) and IDs of departed clients are rejected even after their slot
+ * is reused. Player data is kept column-wise in a PlayerStore so per-tick
+ * passes scan contiguous arrays, and positions are mirrored into a
+ * CollisionEngine so collision checks only look at nearby players.
  */
 class ClientManager {
 public:
+    /**
+     * @param engine Broadphase used for collision checks.
+     */
+    explicit ClientManager(CollisionEngineType engine = CollisionEngineType::Grid);
+
     /**
      * @brief Registers a new client given its socket address.
      * 
      * Generates a unique client ID and stores its metadata for tracking.
      * 
      * @param addr Socket address of the incoming client.
-     * @return int Assigned unique client ID.
+     * @param codec Snapshot encoding agreed for this client.
+     * @return int Assigned unique client ID, or -1 if the server is full.
      */
-    int registerClient(const sockaddr_in& addr);
+    int registerClient(const sockaddr_in& addr, PlayerCodec codec = PLAYER_CODEC_PROTOBUF);
 
     /**
      * @brief Checks if a client is already known based on IP:Port.
      * 
-     * @param ip_port The IP:Port string identifier.
+     * @param key The packed IP:Port identifier.
      * @return true if the client is already registered.
      */
-    bool isKnown(const std::string& ip_port) const;
+    bool isKnown(EndpointKey key) const;
 
     /**
-     * @brief Retrieves the client struct associated with a given IP:Port.
+     * @brief Retrieves the connection info associated with a given IP:Port.
      * 
-     * @param ip_port The IP:Port string identifier.
-     * @return Client& Reference to the stored client.
+     * @param key The packed IP:Port identifier.
+     * @return const Client& Reference to the stored record.
+     * @throws std::out_of_range if the client is not registered.
      */
-    Client& getClient(const std::string& ip_port);
+    const Client& getClient(EndpointKey key) const;
 
     /**
-     * @brief Formats a sockaddr_in as an IP:Port string.
+     * @brief Checks if a client ID is live (not departed, not stale).
+     * 
+     * @param id Client ID.
+     * @return true if the ID belongs to a registered client.
+     */
+    bool hasClient(int id) const { return players.rowOf(id) >= 0; }
+
+    /**
+     * @brief Packs a sockaddr_in into the key used for client lookups.
      * 
      * @param addr The socket address.
-     * @return std::string IP:Port formatted string.
+     * @return EndpointKey Packed IP:Port.
      */
-    std::string getClientKey(const sockaddr_in& addr) const;
+    EndpointKey getClientKey(const sockaddr_in& addr) const { return makeEndpointKey(addr); }
 
     /**
      * @brief Validates whether an incoming update is from a known client.
@@ -54,19 +76,29 @@ public:
      * Ensures that the client ID matches the stored IP:Port.
      * 
      * @param id Claimed client ID in the message.
-     * @param ip_port Source IP:Port string of the packet.
+     * @param key Packed source IP:Port of the packet.
      * @return true if the client is valid and registered.
      */
-    bool validateClient(int id, const std::string& ip_port);
+    bool validateClient(int id, EndpointKey key) const;
 
     /**
      * @brief Marks a client as seen by updating its last seen timestamp.
      * 
      * This is used to refresh the client's activity status.
      * 
-     * @param ip_port The IP:Port string identifier of the client.
+     * @param key The packed IP:Port identifier of the client.
      */
-    void markSeen(const std::string& ip_port);
+    void markSeen(EndpointKey key);
+
+    /**
+     * @brief Records that a client decoded the snapshot with sequence `seq`.
+     * 
+     * The newest acknowledged snapshot becomes the client's delta baseline.
+     * 
+     * @param id Registered client ID.
+     * @param seq Acknowledged StatePacket.seq (0 is ignored).
+     */
+    void acknowledge(int id, uint32_t seq);
 
     /**
      * @brief Updates the position of a registered client.
@@ -86,7 +118,7 @@ public:
      * @return int Count of currently registered clients.
      */
     int getClientCount() const {
-        return clients.size();
+        return static_cast<int>(players.size());
     }
 
     /**
@@ -97,33 +129,38 @@ public:
     void pruneInactiveClients();
 
     /**
-     * Broadcast a Protobuf packet to all registered clients.
-     * @param sockfd UDP socket to send with.
-     * @param data Serialized packet to send.
-     */
-    void broadcastBinary(int sockfd, const std::string& data) const;
-
-    /**
-     * Get a read-only reference to the map of connected clients.
-     * @return Map of client ID to ClientInfo.
+     * Get a read-only reference to the columns of connected clients.
+     * @return Player store, one row per client.
      */
-    const std::unordered_map<std::string, Client>& getClients() const { return clients; }
+    const PlayerStore& getClients() const { return players; }
     
     /**
-     * Check if any client is within the given radius of the (x,y) position.
+     * Check that no other client is within the given radius of the (x,y) position.
+     * Radii the collision engine supports are answered by it; larger
+     * ones fall back to a full scan.
      * @param x X coordinate.
      * @param y Y coordinate.
-     * @param radius Distance threshold.
-     * @return true if a collision is detected, false otherwise.
+     * @param my_id Client to ignore (the one moving).
+     * @param min_distance Distance threshold.
+     * @return true if no other client is closer than min_distance.
      */
     bool isCollisionFree(int x, int y, int my_id, int min_distance = 1) const;
 
     void setBlocked(int id, bool status);
 
-    std::unordered_map<std::string, Client>& getClientsMutable();
+    /**
+     * Clear the blocked flag of every client (start of a tick).
+     */
+    void clearBlocked() { players.clearBlocked(); }
+
+    /**
+     * Name of the collision engine in use ("grid", "sap").
+     */
+    const char* getCollisionEngineName() const { return collision->name(); }
 
 
 private:
-    std::unordered_map<std::string, Client> clients; ///< Map from IP:Port to client struct.
-    int nextClientId = 1; ///< Auto-incremented client ID generator.
+    PlayerStore players;      ///< Client columns, one row per client.
+    EndpointTable endpoints;  ///< Packed IP:Port -> client ID.
+    std::unique_ptr<CollisionEngine> collision;  ///< Broadphase over client positions.
 };
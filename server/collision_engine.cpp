@@ -0,0 +1,20 @@
+#include "collision_engine.h"
+#include "spatial_grid.h"
+#include "sweep_and_prune.h"
+#include "../common/config.h"
+
+bool parseCollisionEngine(const std::string& name, CollisionEngineType& type) {
+    if (name == "grid") { type = CollisionEngineType::Grid; return true; }
+    if (name == "sap") { type = CollisionEngineType::SweepAndPrune; return true; }
+    return false;
+}
+
+std::unique_ptr<CollisionEngine> makeCollisionEngine(CollisionEngineType type) {
+    switch (type) {
+        case CollisionEngineType::SweepAndPrune:
+            return std::make_unique<SweepAndPrune>();
+        case CollisionEngineType::Grid:
+            break;
+    }
+    return std::make_unique<SpatialGrid>(COLLISION_CELL_SIZE, COLLISION_GRID_BUCKETS);
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+/**
+ * @brief Broadphase structure that answers "is anyone closer than r?" queries.
+ *
+ * ClientManager mirrors every player's position into one engine and asks it
+ * for collision checks, so engines can be swapped per map without touching
+ * game logic. Players are identified by their ID (a SlotMap handle);
+ * implementations index their per-player data by the handle's slot.
+ */
+class CollisionEngine {
+public:
+    virtual ~CollisionEngine() = default;
+
+    /**
+     * @brief Adds a player (or re-adds it at a new position).
+     */
+    virtual void insert(int id, int x, int y) = 0;
+
+    /**
+     * @brief Moves a player; inserts it if unknown.
+     */
+    virtual void move(int id, int x, int y) = 0;
+
+    /**
+     * @brief Removes a player; unknown IDs are ignored.
+     */
+    virtual void remove(int id) = 0;
+
+    /**
+     * @brief True if any player other than `exclude_id` lies strictly closer than `radius` to (x, y).
+     *
+     * @param radius Must be <= getMaxRadius().
+     */
+    virtual bool anyWithin(int x, int y, int radius, int exclude_id) const = 0;
+
+    /**
+     * @brief Largest radius anyWithin() answers exactly.
+     */
+    virtual int getMaxRadius() const = 0;
+
+    /**
+     * @brief Short name for logs ("grid", "sap").
+     */
+    virtual const char* name() const = 0;
+};
+
+/**
+ * @brief Available broadphase implementations.
+ */
+enum class CollisionEngineType {
+    Grid,           ///< Uniform spatial hash grid (SpatialGrid)
+    SweepAndPrune   ///< Players sorted by x (SweepAndPrune)
+};
+
+/**
+ * @brief Parses "grid" or "sap" into a CollisionEngineType.
+ * @return false if the name is not recognised.
+ */
+bool parseCollisionEngine(const std::string& name, CollisionEngineType& type);
+
+/**
+ * @brief Creates an engine of the given type using the collision settings in config.h.
+ */
+std::unique_ptr<CollisionEngine> makeCollisionEngine(CollisionEngineType type);
@@ -0,0 +1,75 @@
+#include "endpoint_table.h"
+
+EndpointTable::EndpointTable(size_t initial_capacity) {
+    size_t cap = 16;
+    while (cap < initial_capacity) cap <<= 1;
+    keys.assign(cap, EMPTY);
+    ids.assign(cap, -1);
+    mask = cap - 1;
+}
+
+size_t EndpointTable::slotFor(EndpointKey key) const {
+    // Fibonacci hashing: ports and neighbouring addresses differ in the low
+    // bits, the multiply spreads them over the high bits we keep.
+    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+}
+
+size_t EndpointTable::findSlot(EndpointKey key) const {
+    for (size_t slot = slotFor(key);; slot = (slot + 1) & mask) {
+        if (keys[slot] == key) return slot;
+        if (keys[slot] == EMPTY) return keys.size();
+    }
+}
+
+int EndpointTable::find(EndpointKey key) const {
+    size_t slot = findSlot(key);
+    return slot < keys.size() ? ids[slot] : -1;
+}
+
+void EndpointTable::insert(EndpointKey key, int id) {
+    if ((count + 1) * 2 > keys.size()) grow();
+
+    size_t slot = slotFor(key);
+    while (keys[slot] != EMPTY && keys[slot] != key) slot = (slot + 1) & mask;
+    if (keys[slot] == EMPTY) {
+        keys[slot] = key;
+        count++;
+    }
+    ids[slot] = id;
+}
+
+bool EndpointTable::erase(EndpointKey key) {
+    size_t hole = findSlot(key);
+    if (hole == keys.size()) return false;
+
+    // Backward-shift: pull later entries of the probe chain into the hole
+    // unless that would move them in front of their home slot.
+    for (size_t next = (hole + 1) & mask; keys[next] != EMPTY; next = (next + 1) & mask) {
+        size_t home = slotFor(keys[next]);
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            keys[hole] = keys[next];
+            ids[hole] = ids[next];
+            hole = next;
+        }
+    }
+    keys[hole] = EMPTY;
+    ids[hole] = -1;
+    count--;
+    return true;
+}
+
+void EndpointTable::grow() {
+    std::vector<EndpointKey> old_keys(keys.size() * 2, EMPTY);
+    std::vector<int> old_ids(ids.size() * 2, -1);
+    old_keys.swap(keys);
+    old_ids.swap(ids);
+    mask = keys.size() - 1;
+
+    for (size_t i = 0; i < old_keys.size(); ++i) {
+        if (old_keys[i] == EMPTY) continue;
+        size_t slot = slotFor(old_keys[i]);
+        while (keys[slot] != EMPTY) slot = (slot + 1) & mask;
+        keys[slot] = old_keys[i];
+        ids[slot] = old_ids[i];
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "utils.h"
+
+/**
+ * @brief Flat open-addressing hash table from EndpointKey to client ID.
+ *
+ * Keys and IDs live in two parallel arrays with linear probing, so a
+ * lookup hashes one integer and usually touches a single cache line of
+ * keys. Erase uses backward-shift deletion (no tombstones), which keeps
+ * probe chains short under constant join/leave churn. The table grows by
+ * doubling when it passes 50% load.
+ */
+class EndpointTable {
+public:
+    explicit EndpointTable(size_t initial_capacity = 16);
+
+    /**
+     * @brief Returns the ID stored under `key`, or -1.
+     */
+    int find(EndpointKey key) const;
+
+    /**
+     * @brief Stores `id` under `key`, replacing any existing entry.
+     */
+    void insert(EndpointKey key, int id);
+
+    /**
+     * @brief Removes the entry for `key`.
+     * @return true if an entry was removed.
+     */
+    bool erase(EndpointKey key);
+
+    size_t size() const { return count; }
+    size_t capacity() const { return keys.size(); }
+
+private:
+    // Endpoint keys use 48 bits, so an all-ones key never occurs.
+    static constexpr EndpointKey EMPTY = ~EndpointKey{0};
+
+    size_t slotFor(EndpointKey key) const;
+    size_t findSlot(EndpointKey key) const;
+    void grow();
+
+    std::vector<EndpointKey> keys;  ///< EMPTY marks a free slot
+    std::vector<int> ids;           ///< Parallel to keys
+    size_t mask = 0;
+    size_t count = 0;
+};
@@ -0,0 +1,98 @@
+#include "event_loop.h"
+#include <iostream>
+#include <cerrno>
+#include <cstdio>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+
+constexpr int MAX_EVENTS = 64;
+
+EventLoop::EventLoop() {
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0) {
+        perror("epoll_create1 failed");
+    }
+}
+
+EventLoop::~EventLoop() {
+    for (const auto& [fd, _] : timers) {
+        close(fd);
+    }
+    if (epollFd >= 0) {
+        close(epollFd);
+    }
+}
+
+bool EventLoop::addReader(int fd, IoCallback cb) {
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = fd;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+        perror("epoll_ctl failed");
+        return false;
+    }
+    handlers[fd] = std::move(cb);
+    return true;
+}
+
+int EventLoop::addTimer(int interval_ms, TimerCallback cb) {
+    int tfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (tfd < 0) {
+        perror("timerfd_create failed");
+        return -1;
+    }
+
+    itimerspec spec{};
+    spec.it_interval.tv_sec = interval_ms / 1000;
+    spec.it_interval.tv_nsec = (interval_ms % 1000) * 1000000L;
+    spec.it_value = spec.it_interval;
+    if (timerfd_settime(tfd, 0, &spec, nullptr) < 0) {
+        perror("timerfd_settime failed");
+        close(tfd);
+        return -1;
+    }
+
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = tfd;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, tfd, &ev) < 0) {
+        perror("epoll_ctl failed");
+        close(tfd);
+        return -1;
+    }
+    timers[tfd] = std::move(cb);
+    return tfd;
+}
+
+void EventLoop::run() {
+    epoll_event events[MAX_EVENTS];
+    running = true;
+
+    while (running) {
+        int n = epoll_wait(epollFd, events, MAX_EVENTS, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            perror("epoll_wait failed");
+            return;
+        }
+
+        for (int i = 0; i < n; ++i) {
+            int fd = events[i].data.fd;
+
+            auto timer = timers.find(fd);
+            if (timer != timers.end()) {
+                uint64_t expirations = 0;
+                if (read(fd, &expirations, sizeof(expirations)) == sizeof(expirations)) {
+                    timer->second(expirations);
+                }
+                continue;
+            }
+
+            auto handler = handlers.find(fd);
+            if (handler != handlers.end()) {
+                handler->second(events[i].events);
+            }
+        }
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+
+/**
+ * @brief Minimal epoll-based event loop for the game server.
+ *
+ * Watches file descriptors for readiness and drives periodic timers through
+ * timerfd, so the server thread sleeps in `epoll_wait()` while idle and wakes
+ * only on incoming traffic or when a tick is due. All callbacks run on the
+ * thread that called `run()`.
+ */
+class EventLoop {
+public:
+    /**
+     * @brief Callback invoked when a watched descriptor becomes ready.
+     *
+     * Receives the epoll event mask (EPOLLIN, EPOLLERR, ...).
+     */
+    using IoCallback = std::function<void(uint32_t events)>;
+
+    /**
+     * @brief Callback invoked when a timer fires.
+     *
+     * Receives the number of expirations since the last call (more than 1
+     * means the loop fell behind and ticks were coalesced).
+     */
+    using TimerCallback = std::function<void(uint64_t expirations)>;
+
+    EventLoop();
+    ~EventLoop();
+
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    /**
+     * @brief Watches a descriptor for read readiness (level-triggered).
+     *
+     * @param fd Descriptor to watch; the caller keeps ownership.
+     * @param cb Invoked on the loop thread whenever `fd` is readable.
+     * @return true on success, false if `epoll_ctl` failed.
+     */
+    bool addReader(int fd, IoCallback cb);
+
+    /**
+     * @brief Creates a periodic monotonic timer.
+     *
+     * @param interval_ms Period in milliseconds; the first expiry is one period from now.
+     * @param cb Invoked on the loop thread at every expiry.
+     * @return The timerfd (owned by the loop), or -1 on failure.
+     */
+    int addTimer(int interval_ms, TimerCallback cb);
+
+    /**
+     * @brief Runs the loop until `stop()` is called.
+     */
+    void run();
+
+    /**
+     * @brief Requests the loop to exit after the current batch of events.
+     */
+    void stop() { running = false; }
+
+private:
+    int epollFd = -1;                                  ///< epoll instance
+    bool running = false;                              ///< Cleared by stop()
+    std::unordered_map<int, IoCallback> handlers;      ///< fd -> readiness callback
+    std::unordered_map<int, TimerCallback> timers;     ///< timerfd -> tick callback
+};
@@ -1,83 +1,116 @@
 #include "game_manager.h"
 #include <iostream>
+#include <algorithm>
 #include <arpa/inet.h>
 #include "../common/config.h"
+#include "utils.h"
 
 
 using GameState = ::GameState;
 
-GameManager::GameManager(int max_players, int wait_time_sec)
+GameManager::GameManager(int max_players, int wait_time_sec, Transport& transport,
+                         CollisionEngineType collision, int interest_radius, unsigned encode_workers,
+                         size_t client_budget, std::vector<UpdateTier> update_tiers)
     : maxPlayers(max_players),
-      waitTimeSec(wait_time_sec) {}
+      waitTimeSec(wait_time_sec),
+      clientManager(collision),
+      transport(transport),
+      history(SNAPSHOT_HISTORY_TICKS, static_cast<size_t>(std::max(max_players, 0))),
+      broadcaster(interest_radius, encode_workers, client_budget, std::move(update_tiers)) {
+    guiAddr.sin_family = AF_INET;
+    guiAddr.sin_port = htons(9999); // Must match Python GUI's UDP_PORT
+    inet_pton(AF_INET, "127.0.0.1", &guiAddr.sin_addr);
+}
 
-void GameManager::handleProtobufMessage(const Packet& packet, const sockaddr_in& client_addr, int sockfd) {
-    std::string ip_port = clientManager.getClientKey(client_addr);
+void GameManager::handleProtobufMessage(const Packet& packet, const sockaddr_in& client_addr) {
+    InputEvent input;
+    if (!decodeInput(packet, client_addr, input)) {
+        std::cout << "[WARN] Unknown or empty Packet from " << formatSockAddr(client_addr) << std::endl;
+        return;
+    }
+    handleInput(input);
+}
 
-    if (packet.has_hello()) {
+void GameManager::handleInput(const InputEvent& input) {
+    const sockaddr_in& client_addr = input.from;
+    EndpointKey key = clientManager.getClientKey(client_addr);
+
+    if (input.type == InputEvent::Type::Hello) {
         if (!canAcceptClients()) {
-            std::cout << "[REJECT] Late HELLO from " << ip_port << std::endl;
+            std::cout << "[REJECT] Late HELLO from " << formatSockAddr(client_addr) << std::endl;
             return;
         }
 
-        if (!clientManager.isKnown(ip_port)) {
-            int id = clientManager.registerClient(client_addr);
-            std::cout << "[HANDSHAKE] Registered client " << ip_port << " -> ID " << id << std::endl;
+        if (!clientManager.isKnown(key)) {
+            // Unknown codecs (newer clients) fall back to plain protobuf.
+            PlayerCodec codec = input.codec == PLAYER_CODEC_PACKED ? PLAYER_CODEC_PACKED : PLAYER_CODEC_PROTOBUF;
+            int id = clientManager.registerClient(client_addr, codec);
+            if (id < 0) {
+                std::cout << "[REJECT] Server full, HELLO from " << formatSockAddr(client_addr) << std::endl;
+                return;
+            }
+            std::cout << "[HANDSHAKE] Registered client " << formatSockAddr(client_addr) << " -> ID " << id << std::endl;
 
             Packet reply;
             reply.mutable_welcome()->set_id(id);
+            reply.mutable_welcome()->set_codec(codec);
 
             std::string binary;
             reply.SerializeToString(&binary);
-            sendto(sockfd, binary.data(), binary.size(), 0, (sockaddr*)&client_addr, sizeof(client_addr));
+            transport.sendTo(client_addr, binary.data(), binary.size());
         }
 
-    } else if (packet.has_ping()) {
-        int id = packet.ping().id();
+    } else if (input.type == InputEvent::Type::Ping) {
+        int id = input.id;
 
-        if (!clientManager.validateClient(id, ip_port)) {
-            std::cout << "[WARN] Invalid PING from ID=" << id << " at " << ip_port << std::endl;
+        if (!clientManager.validateClient(id, key)) {
+            std::cout << "[WARN] Invalid PING from ID=" << id << " at " << formatSockAddr(client_addr) << std::endl;
             return;
         }
 
-        clientManager.markSeen(ip_port);
+        clientManager.markSeen(key);
+        clientManager.acknowledge(id, input.ack);
 
-    } else if (packet.has_client_update()) {
+    } else if (input.type == InputEvent::Type::Update) {
         if (state != GameState::STARTED) return;
 
-        const auto& update = packet.client_update();
-        int id = update.id();
-        int x = update.x();
-        int y = update.y();
-
-        if (clientManager.validateClient(id, ip_port)) {
-            if (clientManager.isCollisionFree(x, y, id, 50)) {
-                clientManager.updateClientPosition(id, x, y);
-                clientManager.setBlocked(id, false);
-                std::cout << "[UPDATE] ID=" << id << " → (" << x << "," << y << ")\n";
-            } else {
-                clientManager.setBlocked(id, true);
-                std::cout << "[BLOCKED] ID=" << id << " attempted to move too close to another player\n";
-            }
+        int id = input.id;
+        int x = input.x;
+        int y = input.y;
+
+        if (clientManager.validateClient(id, key)) {
+            // Collision is resolved for the whole tick in resolveMoves(), so
+            // the outcome does not depend on arrival order.
+            clientManager.markSeen(key);
+            clientManager.acknowledge(id, input.ack);
+            pendingMoves.push_back({id, x, y});
         } else {
-            std::cout << "[DROP] Mismatched update from " << ip_port << std::endl;
+            std::cout << "[DROP] Mismatched update from " << formatSockAddr(client_addr) << std::endl;
         }
-
-    } else {
-        std::cout << "[WARN] Unknown or empty Packet from " << ip_port << std::endl;
     }
 }
 
 
 
 void GameManager::update() {
+    advanceState();
+    history.record(tickCounter, clientManager.getClients());
+    publishSnapshot();
+}
+
+void GameManager::advanceState() {
     tickCounter++;
-    for (auto& [_, client] : clientManager.getClientsMutable()) {
-        client.blocked = false;
-    }
+    clientManager.clearBlocked();
     // --- Step 1: Prune inactive clients and count current ones ---
     clientManager.pruneInactiveClients();
     int current_players = clientManager.getClientCount();
 
+    // --- Step 1b: Apply the moves buffered since the last tick ---
+    if (state == GameState::STARTED) {
+        resolveMoves();
+    }
+    pendingMoves.clear();
+
     // --- Step 2: Handle ENDED state (no further updates allowed) ---
     if (state == GameState::ENDED) {
         if (lastLoggedState != state) {
@@ -135,34 +168,54 @@ void GameManager::update() {
 }
 
 
-void GameManager::broadcastToAll(int sockfd) {
-    Packet wrapper;
-    StatePacket* sp = wrapper.mutable_state_packet();
-    sp->set_state(static_cast<::GameState>(state));
-    sp->set_tick(tickCounter);
-
-    for (const auto& [_, client] : clientManager.getClients()) {
-        Player* p = sp->add_players();
-        p->set_id(client.id);
-        p->set_x(client.x);
-        p->set_y(client.y);
-        p->set_blocked(client.blocked);
-    }
-
+void GameManager::resolveMoves() {
+    // Latest move per player wins; players are then resolved in ID order, so
+    // on a conflict the lower ID keeps its spot.
+    std::stable_sort(pendingMoves.begin(), pendingMoves.end(),
+                     [](const PendingMove& a, const PendingMove& b) { return a.id < b.id; });
 
-    std::string binary;
-    wrapper.SerializeToString(&binary);
-    clientManager.broadcastBinary(sockfd, binary);
+    for (size_t i = 0; i < pendingMoves.size(); ++i) {
+        if (i + 1 < pendingMoves.size() && pendingMoves[i + 1].id == pendingMoves[i].id) continue;
+        const PendingMove& move = pendingMoves[i];
+        if (!clientManager.hasClient(move.id)) continue;  // Pruned this tick
 
-    // Send state packet to local viewer GUI
-    sockaddr_in gui_addr{};
-    gui_addr.sin_family = AF_INET;
-    gui_addr.sin_port = htons(9999); // Must match Python GUI's UDP_PORT
-    inet_pton(AF_INET, "127.0.0.1", &gui_addr.sin_addr);
+        // The grid holds accepted moves of lower IDs and current positions
+        // of everyone else.
+        if (clientManager.isCollisionFree(move.x, move.y, move.id, MIN_PLAYER_DISTANCE)) {
+            clientManager.updateClientPosition(move.id, move.x, move.y);
+            std::cout << "[UPDATE] ID=" << move.id << " → (" << move.x << "," << move.y << ")\n";
+        } else {
+            clientManager.setBlocked(move.id, true);
+            std::cout << "[BLOCKED] ID=" << move.id << " attempted to move too close to another player\n";
+        }
+    }
+}
 
-    sendto(sockfd, binary.data(), binary.size(), 0,
-        (sockaddr*)&gui_addr, sizeof(gui_addr));
+void GameManager::publishSnapshot() {
+    WorldSnapshot* snap = snapshots.beginWrite();
+    if (!snap) return;  // Broadcast thread still encoding the previous one; it will catch up.
+
+    snap->sequence = ++snapshotSequence;
+    snap->tick = tickCounter;
+    snap->state = state;
+    snap->players.clear();
+    const PlayerStore& players = clientManager.getClients();
+    for (size_t i = 0, n = players.size(); i < n; ++i) {
+        snap->players.push_back({players.getIds()[i], players.getX()[i], players.getY()[i],
+                                 players.getBlocked()[i] != 0, players.getAcked()[i],
+                                 players.getInfo()[i].codec, players.getInfo()[i].addr});
+    }
+    snapshots.publish();
+}
 
+void GameManager::broadcastToAll() {
+    const WorldSnapshot* snap = snapshots.acquire();
+    if (!snap) return;
+    if (snap->sequence != lastBroadcastSequence) {
+        lastBroadcastSequence = snap->sequence;
+        broadcaster.broadcast(*snap, transport, guiAddr);
+    }
+    snapshots.release();
 }
 
 bool GameManager::canAcceptClients() const {
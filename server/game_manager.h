@@ -2,12 +2,32 @@
 #define GAME_MANAGER_H
 
 #include "client_manager.h"
+#include "input_event.h"
+#include "transport.h"
+#include "world_snapshot.h"
+#include "snapshot_broadcaster.h"
+#include "snapshot_history.h"
 #include "../generated/game.pb.h"
+#include "../common/config.h"
 #include <chrono>
+#include <vector>
 
 class GameManager {
 public:
-    GameManager(int max_players, int wait_time_sec);
+    /**
+     * @param max_players Player count that starts the game immediately.
+     * @param wait_time_sec Seconds to wait for players before starting anyway.
+     * @param transport Outgoing datagram path (replies and broadcasts); must outlive the manager.
+     * @param collision Broadphase used for collision checks on this map.
+     * @param interest_radius Area-of-interest radius for broadcasts (0 = whole world).
+     * @param encode_workers Threads encoding per-client snapshots (1 = serial).
+     * @param client_budget Bytes each client may be sent per snapshot (0 = unlimited).
+     * @param update_tiers Distance-based update rates for remote players (empty = every snapshot).
+     */
+    GameManager(int max_players, int wait_time_sec, Transport& transport,
+                CollisionEngineType collision = CollisionEngineType::Grid,
+                int interest_radius = AOI_RADIUS, unsigned encode_workers = ENCODE_WORKERS,
+                size_t client_budget = CLIENT_SNAPSHOT_BUDGET, std::vector<UpdateTier> update_tiers = {});
 
     /**
      * Check if the game is currently in the STARTED state.
@@ -22,35 +42,99 @@ public:
     bool canAcceptClients() const;
 
     /**
-     * Advance the game tick counter and remove inactive clients.
+     * Advance the game tick counter and remove inactive clients, then
+     * record the tick in the history and publish the resulting world
+     * snapshot for broadcasting.
+     * Runs on the simulation thread.
      */
     void update();
 
     /**
-     * Broadcast the full game state to all connected clients.
-     * Uses a StatePacket inside a Protobuf Packet.
-     * @param sockfd UDP socket descriptor used to send data.
+     * Broadcast the latest published snapshot to all connected clients.
+     * Each client gets a StatePacket with the players in its area of
+     * interest. Reads only the snapshot, so it may run on a separate
+     * broadcast thread concurrently with update() and handleInput(); a
+     * snapshot is sent at most once.
+     */
+    void broadcastToAll();
+
+    /**
+     * Sequence number of the last published snapshot (simulation thread).
+     */
+    uint64_t getPublishedSequence() const { return snapshotSequence; }
+
+    /**
+     * Per-client snapshot size stats (broadcast thread).
+     */
+    const BroadcastStats& getBroadcastStats() const { return broadcaster.getStats(); }
+
+    /**
+     * Print and reset per-client snapshot size stats (broadcast thread).
+     */
+    void logAndResetBroadcastStats() { broadcaster.logAndResetStats(); }
+
+    /**
+     * Player state of recent ticks, recorded by update() (simulation thread).
      */
-    void broadcastToAll(int sockfd);
+    const SnapshotHistory& getHistory() const { return history; }
+
+    /**
+     * Snapshots skipped because the broadcast thread was still busy.
+     */
+    uint64_t getSkippedSnapshots() const { return snapshots.getSkipped(); }
 
     /**
      * Handle a Protobuf message received from a client.
      * Performs registration, ping processing, and client updates.
      * @param packet Parsed Protobuf packet.
      * @param client_addr The address of the client.
-     * @param sockfd Socket used for sending responses.
      */
-    void handleProtobufMessage(const Packet& packet, const sockaddr_in& client_addr, int sockfd);
+    void handleProtobufMessage(const Packet& packet, const sockaddr_in& client_addr);
+
+    /**
+     * Apply a decoded client input (HELLO, PING or UPDATE).
+     * Registration and validation happen here, on the simulation thread,
+     * so the handshake is consistent whichever receive worker decoded it.
+     * @param input Decoded input event.
+     */
+    void handleInput(const InputEvent& input);
+
+    /**
+     * Name of the collision engine in use ("grid", "sap").
+     */
+    const char* getCollisionEngineName() const { return clientManager.getCollisionEngineName(); }
 
 private:
-    GameState state;               ///< Current game state (WAITING, STARTED, etc.)
-    int tickCounter;               ///< Game tick count
+    /**
+     * A validated position update waiting for the next tick.
+     */
+    struct PendingMove {
+        int id;
+        int x;
+        int y;
+    };
+
+    void advanceState();
+    void resolveMoves();
+    void publishSnapshot();
+
+    GameState state = GameState::WAITING; ///< Current game state (WAITING, STARTED, etc.)
+    int tickCounter = 0;           ///< Game tick count
     int maxPlayers;               ///< Max allowed players
     int waitTimeSec;              ///< Seconds to wait before game auto-starts
-    std::chrono::steady_clock::time_point startTime;
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
     GameState lastLoggedState = GameState::UNKNOWN; ///< Last logged state for info messages
 
     ClientManager clientManager;  ///< Tracks all client states and metadata
+    Transport& transport;         ///< Outgoing datagram path
+    std::vector<PendingMove> pendingMoves;  ///< Updates received since the last tick
+    SnapshotHistory history;      ///< Player state of the last SNAPSHOT_HISTORY_TICKS ticks
+
+    SnapshotExchange snapshots;          ///< Simulation -> broadcast hand-off
+    uint64_t snapshotSequence = 0;       ///< Last published sequence (simulation thread)
+    uint64_t lastBroadcastSequence = 0;  ///< Last broadcast sequence (broadcast thread)
+    SnapshotBroadcaster broadcaster;     ///< Per-client encoding (broadcast thread)
+    sockaddr_in guiAddr{};        ///< Local viewer GUI that mirrors every broadcast
 };
 
 #endif // GAME_MANAGER_H
\ No newline at end of file
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <netinet/in.h>
+#include "../generated/game.pb.h"
+#include "../common/config.h"
+
+/**
+ * @brief A decoded client input, detached from its Protobuf packet.
+ *
+ * Receive workers turn datagrams into InputEvents so the simulation thread
+ * never touches raw buffers or parses Protobuf. Only client → server
+ * messages are represented.
+ */
+struct InputEvent {
+    enum class Type : uint8_t {
+        Hello,   ///< Registration request
+        Ping,    ///< Keep-alive while waiting
+        Update   ///< Position update while the game runs
+    };
+
+    Type type = Type::Hello;
+    int id = 0;          ///< Claimed client ID (Ping/Update)
+    int x = 0;           ///< Requested X coordinate (Update)
+    int y = 0;           ///< Requested Y coordinate (Update)
+    uint32_t ack = 0;    ///< Newest snapshot seq the client decoded, 0 = none (Ping/Update)
+    PlayerCodec codec = PLAYER_CODEC_PROTOBUF;  ///< Requested snapshot encoding (Hello)
+    sockaddr_in from{};  ///< Source address of the datagram
+};
+
+/**
+ * @brief Converts a parsed Packet into an InputEvent.
+ *
+ * Rejects server → client payloads, empty packets, non-positive IDs and
+ * positions beyond MAX_COORDINATE, so only well-formed client inputs reach
+ * the simulation.
+ *
+ * @param packet Parsed Protobuf packet.
+ * @param from Source address of the datagram.
+ * @param out Filled in on success.
+ * @return true if the packet is a well-formed client input.
+ */
+inline bool decodeInput(const Packet& packet, const sockaddr_in& from, InputEvent& out) {
+    out.from = from;
+    switch (packet.payload_case()) {
+        case Packet::kHello:
+            out.type = InputEvent::Type::Hello;
+            out.id = 0;
+            out.codec = packet.hello().codec();
+            return true;
+        case Packet::kPing:
+            out.type = InputEvent::Type::Ping;
+            out.id = packet.ping().id();
+            out.ack = packet.ping().ack_seq();
+            return out.id > 0;
+        case Packet::kClientUpdate:
+            out.type = InputEvent::Type::Update;
+            out.id = packet.client_update().id();
+            out.x = packet.client_update().x();
+            out.y = packet.client_update().y();
+            out.ack = packet.client_update().ack_seq();
+            return out.id > 0 &&
+                   out.x >= -MAX_COORDINATE && out.x <= MAX_COORDINATE &&
+                   out.y >= -MAX_COORDINATE && out.y <= MAX_COORDINATE;
+        default:
+            return false;
+    }
+}
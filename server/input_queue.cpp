@@ -0,0 +1,36 @@
+#include "input_queue.h"
+#include <cstdio>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+InputQueue::InputQueue(size_t capacity)
+    : queue(capacity) {
+    notifyFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (notifyFd < 0) {
+        perror("eventfd failed");
+    }
+}
+
+InputQueue::~InputQueue() {
+    if (notifyFd >= 0) close(notifyFd);
+}
+
+bool InputQueue::push(const InputEvent& input) {
+    if (queue.tryPush(input)) return true;
+    dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void InputQueue::notify() {
+    uint64_t one = 1;
+    if (write(notifyFd, &one, sizeof(one)) < 0) {
+        perror("eventfd write failed");
+    }
+}
+
+void InputQueue::consumeNotification() {
+    // EAGAIN just means no notification is pending; queued inputs are still taken.
+    uint64_t counter;
+    ssize_t r = read(notifyFd, &counter, sizeof(counter));
+    (void)r;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "mpsc_queue.h"
+#include "input_event.h"
+
+/**
+ * @brief Hand-off of decoded inputs from receive workers to the simulation thread.
+ *
+ * Workers push into a shared lock-free MPSC queue and then ring an eventfd
+ * that the simulation's event loop watches; the simulation drains the
+ * queue when woken. Nothing on either side blocks: when the queue is full
+ * the input is dropped and counted.
+ */
+class InputQueue {
+public:
+    explicit InputQueue(size_t capacity);
+    ~InputQueue();
+
+    InputQueue(const InputQueue&) = delete;
+    InputQueue& operator=(const InputQueue&) = delete;
+
+    /**
+     * @brief Queues one input (any thread).
+     * @return false if the queue was full and the input was dropped.
+     */
+    bool push(const InputEvent& input);
+
+    /**
+     * @brief Wakes the consumer (any thread); call once after a burst of pushes.
+     */
+    void notify();
+
+    /**
+     * @brief eventfd that becomes readable after notify().
+     */
+    int getNotifyFd() const { return notifyFd; }
+
+    /**
+     * @brief Consumes the notification and pops every queued input (consumer thread only).
+     *
+     * @param fn Called with each input in queue order.
+     * @return Number of inputs handled.
+     */
+    template <typename Fn>
+    size_t drain(Fn&& fn) {
+        consumeNotification();
+        size_t n = 0;
+        InputEvent input;
+        while (queue.tryPop(input)) {
+            fn(input);
+            n++;
+        }
+        return n;
+    }
+
+    /**
+     * @brief Inputs dropped because the queue was full; resets the counter.
+     */
+    uint64_t takeDropped() { return dropped.exchange(0, std::memory_order_relaxed); }
+
+private:
+    void consumeNotification();
+
+    MpscQueue<InputEvent> queue;
+    int notifyFd = -1;
+    std::atomic<uint64_t> dropped{0};
+};
@@ -0,0 +1,80 @@
+#include "interest_grid.h"
+#include "proximity_kernel.h"
+#include <algorithm>
+
+namespace {
+
+int64_t cellOf(int v, int size) {
+    int64_t q = v / size;
+    return (v % size < 0) ? q - 1 : q;
+}
+
+}  // namespace
+
+uint32_t InterestGrid::bucketFor(int64_t cx, int64_t cy) const {
+    uint64_t h = (static_cast<uint64_t>(cx) * 0x9E3779B97F4A7C15ull) ^
+                 (static_cast<uint64_t>(cy) * 0xC2B2AE3D27D4EB4Full);
+    return static_cast<uint32_t>(h >> 32) & mask;
+}
+
+uint32_t InterestGrid::bucketAt(int x, int y) const {
+    return bucketFor(cellOf(x, radius), cellOf(y, radius));
+}
+
+void InterestGrid::build(const int32_t* xs, const int32_t* ys, size_t count, int r) {
+    radius = std::max(1, std::min(r, static_cast<int>(PROXIMITY_MAX_RADIUS)));
+
+    // About two buckets per point keeps unrelated cells from sharing much.
+    size_t buckets = 64;
+    while (buckets < count * 2) buckets <<= 1;
+    mask = static_cast<uint32_t>(buckets - 1);
+
+    bucketStart.assign(buckets + 1, 0);
+    bucketOf.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        bucketOf[i] = bucketAt(xs[i], ys[i]);
+        bucketStart[bucketOf[i] + 1]++;
+    }
+    for (size_t b = 0; b < buckets; ++b) bucketStart[b + 1] += bucketStart[b];
+
+    sortedX.resize(count);
+    sortedY.resize(count);
+    sortedIndex.resize(count);
+    // bucketStart[b] doubles as the fill cursor, then is shifted back.
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t pos = bucketStart[bucketOf[i]]++;
+        sortedX[pos] = xs[i];
+        sortedY[pos] = ys[i];
+        sortedIndex[pos] = static_cast<uint32_t>(i);
+    }
+    for (size_t b = buckets; b > 0; --b) bucketStart[b] = bucketStart[b - 1];
+    bucketStart[0] = 0;
+}
+
+void InterestGrid::query(int x, int y, std::vector<uint32_t>& out) const {
+    if (bucketStart.empty()) return;
+    const int64_t cx = cellOf(x, radius);
+    const int64_t cy = cellOf(y, radius);
+
+    uint32_t visited[9];
+    int visited_count = 0;
+    for (int64_t dy = -1; dy <= 1; ++dy) {
+        for (int64_t dx = -1; dx <= 1; ++dx) {
+            uint32_t bucket = bucketFor(cx + dx, cy + dy);
+            bool seen = false;
+            for (int i = 0; i < visited_count; ++i) seen |= (visited[i] == bucket);
+            if (seen) continue;
+            visited[visited_count++] = bucket;
+
+            for (size_t base = bucketStart[bucket], end = bucketStart[bucket + 1]; base < end;
+                 base += PROXIMITY_BLOCK) {
+                size_t n = end - base < PROXIMITY_BLOCK ? end - base : PROXIMITY_BLOCK;
+                uint64_t hits = proximityMask(sortedX.data() + base, sortedY.data() + base, n, x, y, radius);
+                while (hits) {
+                    out.push_back(sortedIndex[base + __builtin_ctzll(hits)]);
+                    hits &= hits - 1;
+                }
+            }
+        }
+    }
+}
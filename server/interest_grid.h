@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Read-only spatial index over one snapshot, for area-of-interest queries.
+ *
+ * Rebuilt from scratch for every broadcast (the broadcast thread cannot
+ * share the simulation's incremental CollisionEngine). Cells have the edge
+ * length of the interest radius, so the 3x3 block around a viewer covers
+ * everything in range. Cells hash into buckets and the points are
+ * counting-sorted by bucket into flat x/y/index arrays, so a build is two
+ * linear passes and a query scans contiguous memory with the SIMD
+ * proximity kernel.
+ */
+class InterestGrid {
+public:
+    /**
+     * @brief Indexes points (xs[i], ys[i]) for queries of the given radius.
+     *
+     * @param radius Interest radius (> 0, <= PROXIMITY_MAX_RADIUS); also the cell size.
+     */
+    void build(const int32_t* xs, const int32_t* ys, size_t count, int radius);
+
+    /**
+     * @brief Appends to `out` the index of every point strictly closer than the radius to (x, y).
+     *
+     * Indices refer to the arrays passed to build(); the order is unspecified.
+     */
+    void query(int x, int y, std::vector<uint32_t>& out) const;
+
+private:
+    uint32_t bucketFor(int64_t cx, int64_t cy) const;
+    uint32_t bucketAt(int x, int y) const;
+
+    int radius = 1;
+    uint32_t mask = 0;
+    std::vector<uint32_t> bucketStart;  ///< CSR offsets, size = bucket count + 1
+    std::vector<int32_t> sortedX;
+    std::vector<int32_t> sortedY;
+    std::vector<uint32_t> sortedIndex;
+    std::vector<uint32_t> bucketOf;     ///< Scratch: bucket of each input point
+};
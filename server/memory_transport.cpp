@@ -0,0 +1,29 @@
+#include "memory_transport.h"
+
+void InMemoryTransport::deliver(const sockaddr_in& addr, const void* data, size_t len) {
+    datagrams++;
+    bytes += len;
+    if (sink) {
+        sink(addr, static_cast<const char*>(data), len);
+    }
+    if (retain) {
+        sent.push_back({addr, std::string(static_cast<const char*>(data), len)});
+    }
+}
+
+void InMemoryTransport::sendTo(const sockaddr_in& addr, const void* data, size_t len) {
+    deliver(addr, data, len);
+}
+
+void InMemoryTransport::queue(const sockaddr_in& addr, const void* data, size_t len) {
+    pending.push_back({addr, data, len});
+}
+
+size_t InMemoryTransport::flush() {
+    for (const Pending& p : pending) {
+        deliver(p.addr, p.data, p.len);
+    }
+    size_t n = pending.size();
+    pending.clear();
+    return n;
+}
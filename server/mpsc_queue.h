@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @brief Bounded lock-free multi-producer / single-consumer queue.
+ *
+ * Ring of `capacity` cells (rounded up to a power of two), each tagged with
+ * a sequence number as in Dmitry Vyukov's bounded queue: producers claim a
+ * slot with one CAS on the enqueue position, the single consumer advances
+ * the dequeue position without atomics RMW. Neither side ever takes a lock
+ * or waits; a full queue makes tryPush() fail so producers can drop and
+ * count instead of stalling.
+ *
+ * @tparam T Trivially copyable element type.
+ */
+template <typename T>
+class MpscQueue {
+public:
+    explicit MpscQueue(size_t capacity) {
+        size_t cap = 1;
+        while (cap < capacity) cap <<= 1;
+        mask = cap - 1;
+        cells = std::make_unique<Cell[]>(cap);
+        for (size_t i = 0; i < cap; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /**
+     * @brief Appends an element; safe to call from any number of threads.
+     * @return false if the queue is full.
+     */
+    bool tryPush(const T& value) {
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[pos & mask];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // full
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Removes the oldest element; call from the consumer thread only.
+     * @return false if the queue is empty.
+     */
+    bool tryPop(T& out) {
+        Cell& cell = cells[dequeuePos & mask];
+        size_t seq = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(dequeuePos + 1) < 0) {
+            return false;  // empty, or the producer has not finished writing
+        }
+        out = cell.value;
+        cell.sequence.store(dequeuePos + mask + 1, std::memory_order_release);
+        dequeuePos++;
+        return true;
+    }
+
+    size_t capacity() const { return mask + 1; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask = 0;
+    alignas(64) std::atomic<size_t> enqueuePos{0};   ///< Shared by producers
+    alignas(64) size_t dequeuePos = 0;               ///< Owned by the consumer
+};
@@ -0,0 +1,48 @@
+#include "player_store.h"
+#include <algorithm>
+
+int PlayerStore::add(const Client& client, TimePoint now) {
+    uint32_t row = static_cast<uint32_t>(ids.size());
+    int id = rows.insert(row);
+    if (id < 0) return -1;
+
+    ids.push_back(id);
+    xs.push_back(0);
+    ys.push_back(0);
+    blocked.push_back(0);
+    lastSeen.push_back(now);
+    acked.push_back(0);
+    info.push_back(client);
+    return id;
+}
+
+bool PlayerStore::remove(int id) {
+    int row = rowOf(id);
+    if (row < 0) return false;
+
+    size_t last = ids.size() - 1;
+    if (static_cast<size_t>(row) != last) {
+        ids[row] = ids[last];
+        xs[row] = xs[last];
+        ys[row] = ys[last];
+        blocked[row] = blocked[last];
+        lastSeen[row] = lastSeen[last];
+        acked[row] = acked[last];
+        info[row] = info[last];
+        *rows.get(ids[row]) = static_cast<uint32_t>(row);
+    }
+    ids.pop_back();
+    xs.pop_back();
+    ys.pop_back();
+    blocked.pop_back();
+    lastSeen.pop_back();
+    acked.pop_back();
+    info.pop_back();
+
+    rows.erase(id);
+    return true;
+}
+
+void PlayerStore::clearBlocked() {
+    std::fill(blocked.begin(), blocked.end(), 0);
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "client_info.h"
+#include "slot_map.h"
+
+/**
+ * @brief Structure-of-arrays storage for all connected players.
+ *
+ * Players occupy rows 0..size()-1 of parallel columns: the hot per-tick
+ * fields (id, x, y, blocked, last_seen, acked snapshot) each in their own contiguous
+ * array, and the cold Client record (endpoint key, address) in a separate
+ * one. Tick passes scan just the columns they need, linearly.
+ *
+ * Rows are kept dense by swap-with-last removal, so row order is not
+ * stable; IDs are. An ID is a SlotMap handle that resolves to the current
+ * row in O(1) and stops resolving once the player is removed.
+ */
+class PlayerStore {
+public:
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+    /**
+     * @brief Appends a player at (0, 0).
+     * @return The new ID, or -1 if no more IDs are available.
+     */
+    int add(const Client& info, TimePoint now);
+
+    /**
+     * @brief Removes the player with `id`; the last row moves into its place.
+     * @return true if the ID was live.
+     */
+    bool remove(int id);
+
+    /**
+     * @brief Row of the player with `id`, or -1 for unknown or stale IDs.
+     */
+    int rowOf(int id) const {
+        const uint32_t* row = rows.get(id);
+        return row ? static_cast<int>(*row) : -1;
+    }
+
+    size_t size() const { return ids.size(); }
+
+    /**
+     * @brief Clears the blocked flag of every player.
+     */
+    void clearBlocked();
+
+    // Columns, indexed by row.
+    const std::vector<int>& getIds() const { return ids; }
+    const std::vector<int>& getX() const { return xs; }
+    const std::vector<int>& getY() const { return ys; }
+    const std::vector<uint8_t>& getBlocked() const { return blocked; }
+    const std::vector<TimePoint>& getLastSeen() const { return lastSeen; }
+    const std::vector<uint32_t>& getAcked() const { return acked; }
+    const std::vector<Client>& getInfo() const { return info; }
+
+    void setPosition(int row, int x, int y) {
+        xs[row] = x;
+        ys[row] = y;
+    }
+    void setBlocked(int row, bool status) { blocked[row] = status; }
+    void setLastSeen(int row, TimePoint t) { lastSeen[row] = t; }
+    void setAcked(int row, uint32_t seq) {
+        if (seq > acked[row]) acked[row] = seq;  // Acks may arrive out of order
+    }
+
+private:
+    SlotMap<uint32_t> rows;  ///< ID -> current row
+
+    // Hot columns
+    std::vector<int> ids;
+    std::vector<int> xs;
+    std::vector<int> ys;
+    std::vector<uint8_t> blocked;
+    std::vector<TimePoint> lastSeen;
+    std::vector<uint32_t> acked;  ///< Newest snapshot seq the client acknowledged
+
+    // Cold column
+    std::vector<Client> info;
+};
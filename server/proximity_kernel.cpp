@@ -0,0 +1,135 @@
+#include "proximity_kernel.h"
+#include <immintrin.h>
+
+namespace {
+
+uint64_t scalarMask(const int32_t* xs, const int32_t* ys, size_t n,
+                    int32_t qx, int32_t qy, int32_t radius) {
+    const int32_t limit = radius * radius;
+    uint64_t mask = 0;
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t dx = static_cast<uint32_t>(xs[i]) - static_cast<uint32_t>(qx);
+        uint32_t dy = static_cast<uint32_t>(ys[i]) - static_cast<uint32_t>(qy);
+        // Unsigned abs, then clamp, mirroring the vector versions.
+        dx = static_cast<int32_t>(dx) < 0 ? 0u - dx : dx;
+        dy = static_cast<int32_t>(dy) < 0 ? 0u - dy : dy;
+        int32_t cx = static_cast<int32_t>(dx < static_cast<uint32_t>(radius) ? dx : radius);
+        int32_t cy = static_cast<int32_t>(dy < static_cast<uint32_t>(radius) ? dy : radius);
+        mask |= static_cast<uint64_t>(cx * cx + cy * cy < limit) << i;
+    }
+    return mask;
+}
+
+// SSE2 has no 32-bit abs/min/mullo, so clamp with compare+select and let
+// pmaddwd square and add the (dx, dy) pair packed as two 16-bit halves.
+uint64_t sse2Mask(const int32_t* xs, const int32_t* ys, size_t n,
+                  int32_t qx, int32_t qy, int32_t radius) {
+    const __m128i vqx = _mm_set1_epi32(qx);
+    const __m128i vqy = _mm_set1_epi32(qy);
+    const __m128i vr = _mm_set1_epi32(radius);
+    const __m128i vlimit = _mm_set1_epi32(radius * radius);
+    const __m128i bias = _mm_set1_epi32(INT32_MIN);  // Unsigned compare via signed compare
+    const __m128i vr_biased = _mm_xor_si128(vr, bias);
+
+    auto clampAbs = [&](__m128i d) {
+        __m128i sign = _mm_srai_epi32(d, 31);
+        __m128i a = _mm_sub_epi32(_mm_xor_si128(d, sign), sign);
+        __m128i over = _mm_cmpgt_epi32(_mm_xor_si128(a, bias), vr_biased);
+        return _mm_or_si128(_mm_and_si128(over, vr), _mm_andnot_si128(over, a));
+    };
+
+    uint64_t mask = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i dx = clampAbs(_mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(xs + i)), vqx));
+        __m128i dy = clampAbs(_mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ys + i)), vqy));
+        __m128i pair = _mm_or_si128(dx, _mm_slli_epi32(dy, 16));
+        __m128i d2 = _mm_madd_epi16(pair, pair);
+        __m128i hit = _mm_cmplt_epi32(d2, vlimit);
+        mask |= static_cast<uint64_t>(_mm_movemask_ps(_mm_castsi128_ps(hit))) << i;
+    }
+    if (i < n) mask |= scalarMask(xs + i, ys + i, n - i, qx, qy, radius) << i;
+    return mask;
+}
+
+__attribute__((target("avx2")))
+uint64_t avx2Mask(const int32_t* xs, const int32_t* ys, size_t n,
+                  int32_t qx, int32_t qy, int32_t radius) {
+    const __m256i vqx = _mm256_set1_epi32(qx);
+    const __m256i vqy = _mm256_set1_epi32(qy);
+    const __m256i vr = _mm256_set1_epi32(radius);
+    const __m256i vlimit = _mm256_set1_epi32(radius * radius);
+
+    uint64_t mask = 0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i dx = _mm256_sub_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(xs + i)), vqx);
+        __m256i dy = _mm256_sub_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(ys + i)), vqy);
+        dx = _mm256_min_epu32(_mm256_abs_epi32(dx), vr);
+        dy = _mm256_min_epu32(_mm256_abs_epi32(dy), vr);
+        __m256i d2 = _mm256_add_epi32(_mm256_mullo_epi32(dx, dx), _mm256_mullo_epi32(dy, dy));
+        __m256i hit = _mm256_cmpgt_epi32(vlimit, d2);
+        mask |= static_cast<uint64_t>(_mm256_movemask_ps(_mm256_castsi256_ps(hit))) << i;
+    }
+    if (i < n) mask |= sse2Mask(xs + i, ys + i, n - i, qx, qy, radius) << i;
+    return mask;
+}
+
+__attribute__((target("avx512f")))
+uint64_t avx512Mask(const int32_t* xs, const int32_t* ys, size_t n,
+                    int32_t qx, int32_t qy, int32_t radius) {
+    const __m512i vqx = _mm512_set1_epi32(qx);
+    const __m512i vqy = _mm512_set1_epi32(qy);
+    const __m512i vr = _mm512_set1_epi32(radius);
+    const __m512i vlimit = _mm512_set1_epi32(radius * radius);
+
+    uint64_t mask = 0;
+    for (size_t i = 0; i < n; i += 16) {
+        // Masked loads cover the tail without a scalar loop.
+        __mmask16 live = n - i >= 16 ? __mmask16(0xFFFF) : __mmask16((1u << (n - i)) - 1);
+        __m512i dx = _mm512_sub_epi32(_mm512_maskz_loadu_epi32(live, xs + i), vqx);
+        __m512i dy = _mm512_sub_epi32(_mm512_maskz_loadu_epi32(live, ys + i), vqy);
+        dx = _mm512_maskz_min_epu32(live, _mm512_maskz_abs_epi32(live, dx), vr);
+        dy = _mm512_maskz_min_epu32(live, _mm512_maskz_abs_epi32(live, dy), vr);
+        __m512i d2 = _mm512_add_epi32(_mm512_mullo_epi32(dx, dx), _mm512_mullo_epi32(dy, dy));
+        mask |= static_cast<uint64_t>(_mm512_mask_cmplt_epi32_mask(live, d2, vlimit)) << i;
+    }
+    return mask;
+}
+
+const ProximityKernel selectedKernel = getProximityKernel(detectProximityIsa());
+
+}  // namespace
+
+ProximityKernel getProximityKernel(ProximityIsa isa) {
+    __builtin_cpu_init();
+    switch (isa) {
+        case ProximityIsa::Scalar: return scalarMask;
+        case ProximityIsa::Sse2: return sse2Mask;
+        case ProximityIsa::Avx2: return __builtin_cpu_supports("avx2") ? avx2Mask : nullptr;
+        case ProximityIsa::Avx512: return __builtin_cpu_supports("avx512f") ? avx512Mask : nullptr;
+    }
+    return nullptr;
+}
+
+ProximityIsa detectProximityIsa() {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return ProximityIsa::Avx512;
+    if (__builtin_cpu_supports("avx2")) return ProximityIsa::Avx2;
+    return ProximityIsa::Sse2;
+}
+
+const char* proximityIsaName(ProximityIsa isa) {
+    switch (isa) {
+        case ProximityIsa::Scalar: return "scalar";
+        case ProximityIsa::Sse2: return "sse2";
+        case ProximityIsa::Avx2: return "avx2";
+        case ProximityIsa::Avx512: return "avx512";
+    }
+    return "unknown";
+}
+
+uint64_t proximityMask(const int32_t* xs, const int32_t* ys, size_t n,
+                       int32_t qx, int32_t qy, int32_t radius) {
+    return selectedKernel(xs, ys, n, qx, qy, radius);
+}
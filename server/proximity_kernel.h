@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Batched "is this candidate closer than r?" test over SoA coordinates.
+ *
+ * A kernel tests one query point (qx, qy) against up to PROXIMITY_BLOCK
+ * candidates stored as separate x/y arrays and returns a bit mask where
+ * bit i is set if candidate i is strictly closer than `radius`:
+ * dx*dx + dy*dy < radius*radius.
+ *
+ * All arithmetic is 32-bit integer. Each |dx|, |dy| is clamped to
+ * `radius` before squaring (clamped candidates are never hits), so the sum
+ * cannot overflow as long as radius <= PROXIMITY_MAX_RADIUS. Coordinates
+ * must lie within +-MAX_COORDINATE so differences fit in an int32.
+ *
+ * The widest implementation the CPU supports (AVX-512F, AVX2, else the
+ * SSE2 baseline) is selected once at startup.
+ */
+constexpr size_t PROXIMITY_BLOCK = 64;
+constexpr int32_t PROXIMITY_MAX_RADIUS = 32767;
+
+using ProximityKernel = uint64_t (*)(const int32_t* xs, const int32_t* ys, size_t n,
+                                     int32_t qx, int32_t qy, int32_t radius);
+
+/**
+ * @brief Instruction set a kernel is written for.
+ */
+enum class ProximityIsa { Scalar, Sse2, Avx2, Avx512 };
+
+/**
+ * @brief Returns the kernel for `isa`, or nullptr if this CPU cannot run it.
+ */
+ProximityKernel getProximityKernel(ProximityIsa isa);
+
+/**
+ * @brief Best ISA supported by this CPU.
+ */
+ProximityIsa detectProximityIsa();
+
+/**
+ * @brief Short name for logs ("scalar", "sse2", "avx2", "avx512").
+ */
+const char* proximityIsaName(ProximityIsa isa);
+
+/**
+ * @brief Hit mask for `n` <= PROXIMITY_BLOCK candidates using the runtime-selected kernel.
+ */
+uint64_t proximityMask(const int32_t* xs, const int32_t* ys, size_t n,
+                       int32_t qx, int32_t qy, int32_t radius);
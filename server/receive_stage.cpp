@@ -0,0 +1,96 @@
+#include "receive_stage.h"
+#include <iostream>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+ReceiveStage::ReceiveStage(int batch_size, size_t slot_size)
+    : batchSize(batch_size > 0 ? batch_size : 1),
+      slotSize(slot_size),
+      pool(static_cast<size_t>(batchSize) * slot_size),
+      iovecs(batchSize),
+      addrs(batchSize),
+      msgs(batchSize) {
+    for (int i = 0; i < batchSize; ++i) {
+        iovecs[i].iov_base = pool.data() + static_cast<size_t>(i) * slotSize;
+        iovecs[i].iov_len = slotSize;
+    }
+}
+
+int ReceiveStage::drain(int sockfd, const Handler& handler) {
+    int handled = 0;
+
+    while (true) {
+        // recvmmsg() overwrites msg_namelen and msg_len, so reset the headers per call.
+        for (int i = 0; i < batchSize; ++i) {
+            msghdr& hdr = msgs[i].msg_hdr;
+            std::memset(&hdr, 0, sizeof(hdr));
+            hdr.msg_name = &addrs[i];
+            hdr.msg_namelen = sizeof(sockaddr_in);
+            hdr.msg_iov = &iovecs[i];
+            hdr.msg_iovlen = 1;
+            msgs[i].msg_len = 0;
+        }
+
+        int n = recvmmsg(sockfd, msgs.data(), batchSize, MSG_DONTWAIT, nullptr);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                perror("recvmmsg failed");
+            }
+            return handled;
+        }
+        if (n == 0) return handled;
+
+        stats.record(n, batchSize);
+        for (int i = 0; i < n; ++i) {
+            if (msgs[i].msg_hdr.msg_flags & MSG_TRUNC) {
+                stats.truncated++;
+                continue;
+            }
+            handler(static_cast<const char*>(iovecs[i].iov_base), msgs[i].msg_len, addrs[i]);
+            handled++;
+        }
+
+        // A short batch means the backlog is empty; skip the extra EAGAIN syscall.
+        if (n < batchSize) return handled;
+    }
+}
+
+void ReceiveStats::record(int n, int capacity) {
+    calls++;
+    datagrams += n;
+    if (n == capacity) full_batches++;
+    if (n > max_batch) max_batch = n;
+
+    int bucket = 0;
+    while ((n >> (bucket + 1)) != 0 && bucket < BUCKETS - 1) {
+        bucket++;
+    }
+    histogram[bucket]++;
+}
+
+void ReceiveStats::log(const std::string& source) const {
+    std::cout << "[STATS] " << source
+              << " calls=" << calls
+              << " datagrams=" << datagrams
+              << " avg=" << averageBatch()
+              << " max=" << max_batch
+              << " full=" << full_batches
+              << " truncated=" << truncated
+              << " hist=[";
+    bool first = true;
+    for (int i = 0; i < BUCKETS; ++i) {
+        if (histogram[i] == 0) continue;
+        if (!first) std::cout << " ";
+        std::cout << (1 << i) << ":" << histogram[i];
+        first = false;
+    }
+    std::cout << "]" << std::endl;
+}
+
+void ReceiveStage::logAndResetStats(const std::string& label) {
+    if (stats.calls == 0) return;
+    stats.log((label.empty() ? "" : label + " ") + "recvmmsg N=" + std::to_string(batchSize));
+    stats = ReceiveStats{};
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+/**
+ * @brief Batch-size statistics collected by ReceiveStage.
+ *
+ * `histogram[i]` counts recvmmsg() calls that returned between 2^i and
+ * 2^(i+1)-1 datagrams. A high share of `full_batches` means the socket
+ * backlog holds more than one batch and the batch size should grow.
+ */
+struct ReceiveStats {
+    static constexpr int BUCKETS = 16;
+
+    uint64_t calls = 0;          ///< recvmmsg() calls that returned at least one datagram
+    uint64_t datagrams = 0;      ///< Total datagrams received
+    uint64_t full_batches = 0;   ///< Calls that filled every slot of the ring
+    uint64_t truncated = 0;      ///< Datagrams larger than the slot buffer (dropped)
+    int max_batch = 0;           ///< Largest batch observed
+    uint64_t histogram[BUCKETS] = {};
+
+    double averageBatch() const { return calls ? double(datagrams) / calls : 0.0; }
+
+    /**
+     * @brief Records one batch of `n` datagrams out of `capacity` possible.
+     */
+    void record(int n, int capacity);
+
+    /**
+     * @brief Prints a one-line summary prefixed by `source` (e.g. "recvmmsg N=64").
+     */
+    void log(const std::string& source) const;
+};
+
+/**
+ * @brief Pulls datagrams off a UDP socket in batches with recvmmsg().
+ *
+ * Owns a preallocated ring of `batch_size` fixed-size receive slots that is
+ * reused for every call, so the receive path performs no allocations. Each
+ * `drain()` keeps calling recvmmsg() until the socket would block, handing
+ * every datagram of a batch to the handler before the next call reuses
+ * the slots.
+ */
+class ReceiveStage {
+public:
+    /**
+     * @brief Invoked once per received datagram.
+     *
+     * The data pointer is only valid for the duration of the call.
+     */
+    using Handler = std::function<void(const char* data, size_t len, const sockaddr_in& from)>;
+
+    /**
+     * @param batch_size Maximum datagrams per recvmmsg() call (N).
+     * @param slot_size Size of each receive buffer in bytes.
+     */
+    ReceiveStage(int batch_size, size_t slot_size);
+
+    /**
+     * @brief Reads until EAGAIN, dispatching every datagram to `handler`.
+     *
+     * @param sockfd Non-blocking UDP socket.
+     * @param handler Per-datagram callback.
+     * @return Number of datagrams handled.
+     */
+    int drain(int sockfd, const Handler& handler);
+
+    /**
+     * @brief Read-only access to the accumulated batch statistics.
+     */
+    const ReceiveStats& getStats() const { return stats; }
+
+    /**
+     * @brief Prints a one-line summary of the statistics and resets them.
+     * @param label Optional prefix identifying the receiver (e.g. "worker 2").
+     */
+    void logAndResetStats(const std::string& label = "");
+
+    int getBatchSize() const { return batchSize; }
+
+private:
+    int batchSize;
+    size_t slotSize;
+    std::vector<char> pool;               ///< batchSize * slotSize bytes of receive buffers
+    std::vector<iovec> iovecs;            ///< One iovec per slot, pointing into `pool`
+    std::vector<sockaddr_in> addrs;       ///< Source address per slot
+    std::vector<mmsghdr> msgs;            ///< recvmmsg() descriptors
+    ReceiveStats stats;
+};
@@ -0,0 +1,65 @@
+#include "receive_worker.h"
+#include "../common/config.h"
+#include <iostream>
+#include <string>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+ReceiveWorker::ReceiveWorker(int index, int sockfd, InputQueue& inputs)
+    : index(index),
+      sockfd(sockfd),
+      inputs(inputs),
+      receiver(RECV_BATCH_SIZE, MAX_DATAGRAM_SIZE) {
+    stopFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (stopFd < 0) {
+        perror("eventfd failed");
+    }
+}
+
+ReceiveWorker::~ReceiveWorker() {
+    stop();
+    if (stopFd >= 0) close(stopFd);
+}
+
+void ReceiveWorker::start() {
+    loop.addReader(sockfd, [this](uint32_t) { onReadable(); });
+    loop.addReader(stopFd, [this](uint32_t) { loop.stop(); });
+    loop.addTimer(STATS_LOG_INTERVAL_SEC * 1000, [this](uint64_t) {
+        receiver.logAndResetStats("worker " + std::to_string(index));
+        if (rejected > 0) {
+            std::cout << "[STATS] worker " << index << " rejected=" << rejected << std::endl;
+            rejected = 0;
+        }
+    });
+    thread = std::thread([this]() { run(); });
+}
+
+void ReceiveWorker::stop() {
+    if (!thread.joinable()) return;
+    uint64_t one = 1;
+    if (write(stopFd, &one, sizeof(one)) < 0) {
+        perror("eventfd write failed");
+    }
+    thread.join();
+}
+
+void ReceiveWorker::run() {
+    loop.run();
+}
+
+void ReceiveWorker::onReadable() {
+    int queued = 0;
+    receiver.drain(sockfd, [this, &queued](const char* data, size_t len, const sockaddr_in& from) {
+        InputEvent input;
+        if (!packet.ParseFromArray(data, static_cast<int>(len)) || !decodeInput(packet, from, input)) {
+            rejected++;
+            return;
+        }
+        if (inputs.push(input)) queued++;
+    });
+
+    // One wakeup per received burst; the consumer drains everything queued.
+    if (queued > 0) {
+        inputs.notify();
+    }
+}
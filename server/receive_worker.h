@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <thread>
+#include "event_loop.h"
+#include "receive_stage.h"
+#include "input_queue.h"
+
+/**
+ * @brief Receive thread bound to one SO_REUSEPORT socket.
+ *
+ * Each worker runs its own EventLoop, pulls datagrams with a ReceiveStage,
+ * decodes them into InputEvents and pushes them into the shared lock-free
+ * InputQueue, ringing its eventfd once per received batch. All game state
+ * stays on the simulation thread that drains the queue. The kernel spreads
+ * clients over the sockets by 4-tuple hash.
+ */
+class ReceiveWorker {
+public:
+    /**
+     * @param index Worker number, used in log lines.
+     * @param sockfd Non-blocking UDP socket owned by the caller.
+     * @param inputs Queue shared with the simulation thread; must outlive the worker.
+     */
+    ReceiveWorker(int index, int sockfd, InputQueue& inputs);
+    ~ReceiveWorker();
+
+    ReceiveWorker(const ReceiveWorker&) = delete;
+    ReceiveWorker& operator=(const ReceiveWorker&) = delete;
+
+    /**
+     * @brief Starts the worker thread.
+     */
+    void start();
+
+    /**
+     * @brief Stops the worker thread and waits for it to exit.
+     */
+    void stop();
+
+private:
+    void run();
+    void onReadable();
+
+    int index;
+    int sockfd;
+    InputQueue& inputs;                   ///< Worker -> simulation hand-off
+    int stopFd = -1;                      ///< Simulation -> worker shutdown request
+    EventLoop loop;
+    ReceiveStage receiver;
+    Packet packet;                        ///< Reused parse target
+    uint64_t rejected = 0;                ///< Datagrams that failed to decode
+
+    std::thread thread;
+};
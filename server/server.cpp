@@ -1,29 +1,109 @@
 #include <iostream>
 #include <string>
 #include <cstring>
+#include <memory>
+#include <vector>
 #include <unistd.h>
 #include <arpa/inet.h>
-#include <chrono>
-#include <thread>
 
 #include "game_manager.h"
+#include "event_loop.h"
+#include "receive_stage.h"
+#include "receive_worker.h"
+#include "broadcast_worker.h"
+#include "input_queue.h"
+#include "proximity_kernel.h"
+#include "uring.h"
+#include "udp_transport.h"
 #include "../common/config.h"
 #include "utils.h"
 #include "../generated/game.pb.h"
 
 #define PORT 9000
-#define BUFFER_SIZE 1024
 
-int main() {
-    int sockfd;
-    sockaddr_in server_addr, client_addr;
-    char buffer[BUFFER_SIZE];
+/**
+ * @brief Startup options parsed from the command line.
+ */
+struct ServerOptions {
+    SendMode sendMode = SendMode::Batched; ///< --send-mode plain|batch|gso
+    int workers = RECV_WORKERS;            ///< --workers N
+    bool uring = false;                    ///< --io uring (default: classic)
+    CollisionEngineType collision = CollisionEngineType::Grid; ///< --collision grid|sap
+    int aoiRadius = AOI_RADIUS;            ///< --aoi-radius R (0 = full world)
+    int encodeWorkers = ENCODE_WORKERS;    ///< --encode-workers N
+    int clientBudget = CLIENT_SNAPSHOT_BUDGET; ///< --client-budget BYTES (0 = unlimited)
+    std::vector<UpdateTier> updateTiers;   ///< --update-tiers R:HZ,...,HZ (default UPDATE_TIERS)
+};
 
-    if ((sockfd = socket(AF_INET, SOCK_DGRAM, 0)) < 0) {
+static void printUsage(const char* prog) {
+    std::cerr << "Usage: " << prog << " [--io classic|uring] [--send-mode plain|batch|gso|uring] [--workers N] [--collision grid|sap] [--aoi-radius R] [--encode-workers N] [--client-budget BYTES] [--update-tiers R:HZ,...,HZ]" << std::endl;
+}
+
+static bool parseOptions(int argc, char** argv, ServerOptions& opts) {
+    if (!parseUpdateTiers(UPDATE_TIERS, opts.updateTiers)) return false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--send-mode" && i + 1 < argc) {
+            if (!parseSendMode(argv[++i], opts.sendMode)) return false;
+        } else if (arg == "--io" && i + 1 < argc) {
+            std::string io = argv[++i];
+            if (io != "classic" && io != "uring") return false;
+            opts.uring = (io == "uring");
+        } else if (arg == "--collision" && i + 1 < argc) {
+            if (!parseCollisionEngine(argv[++i], opts.collision)) return false;
+        } else if (arg == "--aoi-radius" && i + 1 < argc) {
+            opts.aoiRadius = std::atoi(argv[++i]);
+            if (opts.aoiRadius < 0 || opts.aoiRadius > PROXIMITY_MAX_RADIUS) {
+                std::cerr << "--aoi-radius must be between 0 and " << PROXIMITY_MAX_RADIUS << std::endl;
+                return false;
+            }
+        } else if (arg == "--encode-workers" && i + 1 < argc) {
+            opts.encodeWorkers = std::atoi(argv[++i]);
+            if (opts.encodeWorkers < 1 || opts.encodeWorkers > static_cast<int>(MAX_ENCODE_WORKERS)) return false;
+        } else if (arg == "--client-budget" && i + 1 < argc) {
+            opts.clientBudget = std::atoi(argv[++i]);
+            if (opts.clientBudget < 0) return false;
+        } else if (arg == "--update-tiers" && i + 1 < argc) {
+            if (!parseUpdateTiers(argv[++i], opts.updateTiers)) return false;
+        } else if (arg == "--workers" && i + 1 < argc) {
+            opts.workers = std::atoi(argv[++i]);
+            if (opts.workers < 1) return false;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Creates a non-blocking UDP socket bound to PORT.
+ *
+ * @param reuse_port Set SO_REUSEPORT so several sockets can share the port.
+ * @return The socket, or -1 on failure.
+ */
+static int createServerSocket(bool reuse_port) {
+    int sockfd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+    if (sockfd < 0) {
         perror("Socket creation failed");
-        return 1;
+        return -1;
+    }
+
+    if (reuse_port) {
+        int one = 1;
+        if (setsockopt(sockfd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) < 0) {
+            perror("setsockopt(SO_REUSEPORT) failed");
+            close(sockfd);
+            return -1;
+        }
     }
 
+    // A broadcast queues one datagram per client at once; give the kernel room for it.
+    int sndbuf = SOCKET_SNDBUF_BYTES;
+    if (setsockopt(sockfd, SOL_SOCKET, SO_SNDBUF, &sndbuf, sizeof(sndbuf)) < 0) {
+        perror("setsockopt(SO_SNDBUF) failed");
+    }
+
+    sockaddr_in server_addr;
     memset(&server_addr, 0, sizeof(server_addr));
     server_addr.sin_family = AF_INET;
     server_addr.sin_addr.s_addr = INADDR_ANY;
@@ -32,31 +112,128 @@ int main() {
     if (bind(sockfd, (const sockaddr*)&server_addr, sizeof(server_addr)) < 0) {
         perror("Bind failed");
         close(sockfd);
+        return -1;
+    }
+    return sockfd;
+}
+
+int main(int argc, char** argv) {
+    ServerOptions opts;
+
+    if (!parseOptions(argc, argv, opts)) {
+        printUsage(argv[0]);
         return 1;
     }
+    if (opts.uring) {
+        if (opts.workers > 1) {
+            std::cerr << "[ERROR] The io_uring backend receives on the tick thread; use --workers 1" << std::endl;
+            return 1;
+        }
+        // io_uring backend sends through the ring as well.
+        opts.sendMode = SendMode::Uring;
+    }
 
-    std::cout << "[START] UDP server running on port " << PORT << std::endl;
-    GameManager game_manager(MAX_PLAYERS, WAIT_TIME_SEC);
+    // One socket per receive worker; with a single worker the simulation
+    // thread reads the socket itself.
+    bool sharded = opts.workers > 1;
+    std::vector<int> sockets;
+    for (int i = 0; i < opts.workers; ++i) {
+        int fd = createServerSocket(sharded);
+        if (fd < 0) {
+            for (int s : sockets) close(s);
+            return 1;
+        }
+        sockets.push_back(fd);
+    }
+    // All sockets share the port, so replies from any of them reach the client
+    // from the address it talks to.
+    int sockfd = sockets[0];
+
+    std::cout << "[START] UDP server running on port " << PORT << " (" << (opts.uring ? "io_uring" : "classic")
+              << " I/O) with " << opts.workers << " receive worker(s)" << std::endl;
+    // +1 destination for the GUI viewer.
+    std::unique_ptr<Transport> transport = makeUdpTransport(sockfd, opts.sendMode, MAX_PLAYERS + 1);
+    std::cout << "[START] Broadcast send mode: " << transport->name() << std::endl;
+    GameManager game_manager(MAX_PLAYERS, WAIT_TIME_SEC, *transport, opts.collision, opts.aoiRadius,
+                             opts.encodeWorkers, opts.clientBudget, opts.updateTiers);
+    std::cout << "[START] Collision engine: " << game_manager.getCollisionEngineName()
+              << ", interest radius: " << opts.aoiRadius
+              << ", encode workers: " << opts.encodeWorkers
+              << ", client budget: " << opts.clientBudget << " B"
+              << ", update tiers: " << opts.updateTiers.size() << std::endl;
+    EventLoop loop;
+
+    // Broadcast: encoding and sending run on their own thread from the
+    // snapshot each tick publishes, never from the live tables.
+    BroadcastWorker broadcaster(game_manager, *transport);
 
-    std::thread([&game_manager, &sockfd]() {
-        while (true) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(BROADCAST_INTERVAL_MS));
+    // Tick: the simulation owns all game state and only runs on the loop
+    // thread, so it never races with packet handling.
+    if (loop.addTimer(BROADCAST_INTERVAL_MS, [&](uint64_t expirations) {
+            if (expirations > 1) {
+                std::cout << "[WARN] Tick overrun, skipped " << (expirations - 1) << " tick(s)" << std::endl;
+            }
             game_manager.update();
-            game_manager.broadcastToAll(sockfd);
-        }
-    }).detach();
+            broadcaster.wake();
+        }) < 0) {
+        for (int s : sockets) close(s);
+        return 1;
+    }
+
+    // Receive (single worker): pull batches with recvmmsg() until EAGAIN each
+    // time the socket becomes readable. The Packet is reused so parsing does
+    // not reallocate.
+    ReceiveStage receiver(RECV_BATCH_SIZE, MAX_DATAGRAM_SIZE);
+    ::Packet packet;
+    auto handle_datagram = [&](const char* data, size_t len, const sockaddr_in& from) {
+        if (!packet.ParseFromArray(data, static_cast<int>(len))) return;
+        game_manager.handleProtobufMessage(packet, from);
+    };
 
-    while (true) {
-        socklen_t len = sizeof(client_addr);
-        ssize_t n = recvfrom(sockfd, buffer, BUFFER_SIZE, MSG_DONTWAIT,
-                             (sockaddr*)&client_addr, &len);
-        if (n > 0) {
-            ::Packet p;
-            if (!p.ParseFromArray(buffer, n)) continue;
-            game_manager.handleProtobufMessage(p, client_addr, sockfd);
+    // Receive (io_uring): one multishot RECVMSG keeps delivering datagrams
+    // into registered buffers; the ring fd wakes the loop when any complete.
+    UringReceiver uring_receiver(URING_RECV_BUFFERS, MAX_DATAGRAM_SIZE);
+
+    // Receive (sharded): workers decode on their own threads and push inputs
+    // into one lock-free queue; the simulation applies them when woken.
+    std::vector<std::unique_ptr<ReceiveWorker>> workers;
+    InputQueue inputs(INPUT_QUEUE_CAPACITY);
+
+    if (opts.uring) {
+        if (!uring_receiver.init(sockfd) ||
+            !loop.addReader(uring_receiver.getFd(), [&](uint32_t) { uring_receiver.drain(handle_datagram); })) {
+            std::cerr << "[ERROR] io_uring receive setup failed" << std::endl;
+            close(sockfd);
+            return 1;
+        }
+    } else if (!sharded) {
+        if (!loop.addReader(sockfd, [&](uint32_t) { receiver.drain(sockfd, handle_datagram); })) {
+            close(sockfd);
+            return 1;
+        }
+    } else {
+        loop.addReader(inputs.getNotifyFd(), [&](uint32_t) {
+            inputs.drain([&](const InputEvent& input) { game_manager.handleInput(input); });
+        });
+        for (int i = 0; i < opts.workers; ++i) {
+            workers.push_back(std::make_unique<ReceiveWorker>(i, sockets[i], inputs));
+            workers.back()->start();
         }
     }
 
-    close(sockfd);
+    loop.addTimer(STATS_LOG_INTERVAL_SEC * 1000, [&](uint64_t) {
+        receiver.logAndResetStats();
+        uring_receiver.logAndResetStats();
+        if (uint64_t dropped = inputs.takeDropped()) {
+            std::cout << "[STATS] input queue dropped=" << dropped << std::endl;
+        }
+    });
+
+    broadcaster.start();
+    loop.run();
+
+    workers.clear();
+    broadcaster.stop();
+    for (int s : sockets) close(s);
     return 0;
-}
\ No newline at end of file
+}
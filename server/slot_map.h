@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Dense, generation-tagged array addressed by 32-bit handles.
+ *
+ * A handle packs a slot index (low SLOT_BITS bits) and the slot's
+ * generation (the bits above), so get() is one bounds check, one array
+ * index and one compare. Erasing bumps the slot's generation and pushes it
+ * on a free list; the next insert() reuses it, and handles issued for the
+ * previous occupant no longer match. Handles are always positive, so they
+ * can be used directly as wire IDs.
+ *
+ * @tparam T Stored element type (default-constructible, copyable).
+ */
+template <typename T>
+class SlotMap {
+public:
+    static constexpr int SLOT_BITS = 16;
+    static constexpr uint32_t MAX_SLOTS = 1u << SLOT_BITS;
+    static constexpr uint32_t SLOT_MASK = MAX_SLOTS - 1;
+    static constexpr uint32_t MAX_GENERATION = 0x7FFF;  ///< Keeps handles positive as int32
+
+    /**
+     * @brief Stores `value` in a free slot.
+     * @return The new handle, or -1 if all MAX_SLOTS slots are in use.
+     */
+    int insert(const T& value) {
+        uint32_t slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            if (slots.size() >= MAX_SLOTS) return -1;
+            slot = static_cast<uint32_t>(slots.size());
+            slots.push_back(Slot{});
+        }
+        slots[slot].value = value;
+        slots[slot].live = true;
+        count++;
+        return makeHandle(slot, slots[slot].generation);
+    }
+
+    /**
+     * @brief Returns the element for `handle`, or nullptr if the handle is stale or invalid.
+     */
+    T* get(int handle) {
+        Slot* s = resolve(handle);
+        return s ? &s->value : nullptr;
+    }
+
+    const T* get(int handle) const {
+        const Slot* s = const_cast<SlotMap*>(this)->resolve(handle);
+        return s ? &s->value : nullptr;
+    }
+
+    /**
+     * @brief Frees the slot for `handle` and invalidates the handle.
+     * @return true if the handle was live.
+     */
+    bool erase(int handle) {
+        Slot* s = resolve(handle);
+        if (!s) return false;
+        s->live = false;
+        s->value = T{};
+        // Generations start at 1 and wrap before the sign bit.
+        s->generation = s->generation == MAX_GENERATION ? 1 : s->generation + 1;
+        freeSlots.push_back(static_cast<uint32_t>(handle) & SLOT_MASK);
+        count--;
+        return true;
+    }
+
+    size_t size() const { return count; }
+
+    /**
+     * @brief Forward iterator over live elements in slot order.
+     */
+    template <typename MapT, typename ValueT>
+    class Iterator {
+    public:
+        Iterator(MapT* map, size_t slot) : map(map), slot(slot) { skipFree(); }
+        ValueT& operator*() const { return map->slots[slot].value; }
+        ValueT* operator->() const { return &map->slots[slot].value; }
+        Iterator& operator++() {
+            ++slot;
+            skipFree();
+            return *this;
+        }
+        bool operator!=(const Iterator& other) const { return slot != other.slot; }
+        bool operator==(const Iterator& other) const { return slot == other.slot; }
+
+    private:
+        void skipFree() {
+            while (slot < map->slots.size() && !map->slots[slot].live) ++slot;
+        }
+        MapT* map;
+        size_t slot;
+    };
+
+    using iterator = Iterator<SlotMap, T>;
+    using const_iterator = Iterator<const SlotMap, const T>;
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, slots.size()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, slots.size()); }
+
+private:
+    struct Slot {
+        T value{};
+        uint16_t generation = 1;
+        bool live = false;
+    };
+
+    static int makeHandle(uint32_t slot, uint32_t generation) {
+        return static_cast<int>((generation << SLOT_BITS) | slot);
+    }
+
+    Slot* resolve(int handle) {
+        if (handle <= 0) return nullptr;
+        uint32_t slot = static_cast<uint32_t>(handle) & SLOT_MASK;
+        uint32_t generation = static_cast<uint32_t>(handle) >> SLOT_BITS;
+        if (slot >= slots.size()) return nullptr;
+        Slot& s = slots[slot];
+        return (s.live && s.generation == generation) ? &s : nullptr;
+    }
+
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;  ///< LIFO, so recently freed slots are reused while warm
+    size_t count = 0;
+};
+
+/**
+ * @brief Slot index part of a SlotMap handle, for side tables indexed by slot.
+ */
+inline uint32_t slotIndexOf(int handle) {
+    return static_cast<uint32_t>(handle) & SlotMap<int>::SLOT_MASK;
+}
@@ -0,0 +1,818 @@
+#include "snapshot_broadcaster.h"
+#include "proximity_kernel.h"
+#include "slot_map.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+#include <google/protobuf/io/coded_stream.h>
+
+namespace {
+
+using google::protobuf::io::CodedOutputStream;
+
+// Worst-case bytes a part spends outside its player and removed-ID entries:
+// Packet oneof tag + length (3), state (2), tick (11), seq, baseline_seq,
+// part, part_count (6 each) and the packed `removed` tag + length (3).
+constexpr size_t PART_HEADER_BYTES = 3 + 2 + 11 + 6 + 6 + 6 + 6 + 3;
+constexpr size_t PART_BUDGET = SNAPSHOT_MTU_PAYLOAD - PART_HEADER_BYTES;
+
+// Packed parts also spend the packed_players tag + length (3), the block
+// header, and up to one byte rounding the player bits.
+constexpr size_t PACKED_PART_BUDGET = PART_BUDGET - 3 - PACKED_HEADER_MAX_BYTES - 1;
+
+// Clients a worker takes from its slice at a time; small enough that a few
+// clients with large interest sets still get spread across workers.
+constexpr size_t ENCODE_GRAIN = 16;
+
+// Wire tags (field number << 3 | wire type) of the messages written by hand.
+constexpr uint8_t TAG_PACKET_STATE_PACKET = (5 << 3) | 2;
+constexpr uint8_t TAG_STATE = (1 << 3) | 0;
+constexpr uint8_t TAG_TICK = (2 << 3) | 0;
+constexpr uint8_t TAG_PLAYERS = (3 << 3) | 2;
+constexpr uint8_t TAG_SEQ = (4 << 3) | 0;
+constexpr uint8_t TAG_BASELINE_SEQ = (5 << 3) | 0;
+constexpr uint8_t TAG_REMOVED = (6 << 3) | 2;
+constexpr uint8_t TAG_PART = (7 << 3) | 0;
+constexpr uint8_t TAG_PART_COUNT = (8 << 3) | 0;
+constexpr uint8_t TAG_PLAYER_ID = (1 << 3) | 0;
+constexpr uint8_t TAG_PLAYER_X = (2 << 3) | 0;
+constexpr uint8_t TAG_PLAYER_Y = (3 << 3) | 0;
+constexpr uint8_t TAG_PLAYER_BLOCKED = (4 << 3) | 0;
+
+char* putVarint(char* p, uint64_t v) {
+    while (v >= 0x80) {
+        *p++ = static_cast<char>(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = static_cast<char>(v);
+    return p;
+}
+
+// int32 fields are sign-extended to 64 bits on the wire, like protobuf does.
+char* putInt32(char* p, int32_t v) {
+    return putVarint(p, static_cast<uint64_t>(static_cast<int64_t>(v)));
+}
+
+size_t int32Size(int32_t v) {
+    return CodedOutputStream::VarintSize32SignExtended(v);
+}
+
+// Sizes and writers of single-byte-tag varint fields; proto3 omits zeros.
+size_t int32FieldSize(int32_t v) {
+    return v ? 1 + int32Size(v) : 0;
+}
+
+size_t uint32FieldSize(uint32_t v) {
+    return v ? 1 + CodedOutputStream::VarintSize32(v) : 0;
+}
+
+char* putInt32Field(char* p, uint8_t tag, int32_t v) {
+    if (!v) return p;
+    *p++ = static_cast<char>(tag);
+    return putInt32(p, v);
+}
+
+char* putUint32Field(char* p, uint8_t tag, uint32_t v) {
+    if (!v) return p;
+    *p++ = static_cast<char>(tag);
+    return putVarint(p, v);
+}
+
+}  // namespace
+
+bool parseUpdateTiers(const std::string& spec, std::vector<UpdateTier>& tiers) {
+    tiers.clear();
+    if (spec.empty()) return true;
+    const double snapshots_per_sec = 1000.0 / BROADCAST_INTERVAL_MS;
+    size_t pos = 0;
+    while (pos <= spec.size()) {
+        size_t comma = spec.find(',', pos);
+        if (comma == std::string::npos) comma = spec.size();
+        std::string item = spec.substr(pos, comma - pos);
+        size_t colon = item.find(':');
+        UpdateTier tier;
+        double hz = 0;
+        try {
+            // Each number must take its whole field: "150abc" is not 150.
+            size_t used = 0;
+            if (colon != std::string::npos) {
+                tier.radius = std::stoi(item.substr(0, colon), &used);
+                if (used != colon) return false;
+            }
+            const std::string rate = item.substr(colon == std::string::npos ? 0 : colon + 1);
+            hz = std::stod(rate, &used);
+            if (used != rate.size()) return false;
+        } catch (const std::exception&) {
+            return false;
+        }
+        const bool last = comma == spec.size();
+        if (!(hz >= MIN_UPDATE_TIER_HZ) || tier.radius < 0 || tier.radius > PROXIMITY_MAX_RADIUS ||
+            (colon == std::string::npos) != last) {
+            return false;
+        }
+        if (!last && (tier.radius == 0 || (!tiers.empty() && tier.radius <= tiers.back().radius))) return false;
+        if (tiers.size() == MAX_UPDATE_TIERS) return false;
+        tier.interval = static_cast<unsigned>(std::max(1.0, std::round(snapshots_per_sec / hz)));
+        tiers.push_back(tier);
+        pos = comma + 1;
+    }
+    return true;
+}
+
+SnapshotBroadcaster::SnapshotBroadcaster(int interest_radius, unsigned encode_workers, size_t client_budget,
+                                         std::vector<UpdateTier> update_tiers)
+    : interestRadius(interest_radius),
+      clientBudget(client_budget),
+      tiers(std::move(update_tiers)),
+      pool(std::min(std::max(1u, encode_workers), MAX_ENCODE_WORKERS)) {
+    for (unsigned w = 0; w < pool.size(); ++w) {
+        contexts.push_back(std::make_unique<EncodeContext>());
+        contexts.back()->index = w;
+    }
+}
+
+void SnapshotBroadcaster::refreshFragments(const WorldSnapshot& snap) {
+    for (const SnapshotPlayer& p : snap.players) {
+        uint32_t slot = slotIndexOf(p.id);
+        if (slot >= fragments.size()) fragments.resize(slot + 1);
+        PlayerFragment& f = fragments[slot];
+        if (f.len && f.id == p.id && f.x == p.x && f.y == p.y && f.blocked == p.blocked) continue;
+
+        f.id = p.id;
+        f.x = p.x;
+        f.y = p.y;
+        f.blocked = p.blocked;
+        uint8_t body = static_cast<uint8_t>(int32FieldSize(p.id) + int32FieldSize(p.x) + int32FieldSize(p.y) + (p.blocked ? 2 : 0));
+        char* out = f.bytes;
+        *out++ = static_cast<char>(TAG_PLAYERS);
+        *out++ = static_cast<char>(body);  // At most 30, always one varint byte
+        out = putInt32Field(out, TAG_PLAYER_ID, p.id);
+        out = putInt32Field(out, TAG_PLAYER_X, p.x);
+        out = putInt32Field(out, TAG_PLAYER_Y, p.y);
+        out = putInt32Field(out, TAG_PLAYER_BLOCKED, p.blocked);
+        f.len = static_cast<uint8_t>(out - f.bytes);
+        stats.reencoded++;
+    }
+}
+
+void SnapshotBroadcaster::writeProtobufPart(std::string& out, const WorldSnapshot& snap, uint32_t seq,
+                                            uint32_t baseline, uint32_t part, uint32_t part_count,
+                                            const int32_t* removed_ids, size_t removed_count,
+                                            const uint32_t* indices, size_t count) const {
+    // Same bytes SerializeToString() would produce: fields in number order, zeros omitted.
+    size_t removed_body = 0;
+    for (size_t r = 0; r < removed_count; ++r) removed_body += int32Size(removed_ids[r]);
+    size_t players_size = 0;
+    for (size_t k = 0; k < count; ++k) players_size += fragments[slotIndexOf(snap.players[indices[k]].id)].len;
+
+    const size_t body = int32FieldSize(snap.state) + int32FieldSize(snap.tick) + players_size +
+                        uint32FieldSize(seq) + uint32FieldSize(baseline) +
+                        (removed_count ? 1 + CodedOutputStream::VarintSize32(removed_body) + removed_body : 0) +
+                        uint32FieldSize(part) + uint32FieldSize(part_count);
+    const size_t total = 1 + CodedOutputStream::VarintSize32(body) + body;
+    out.resize(total + FRAGMENT_BYTES);  // Slack for the fixed-size fragment copies
+
+    char* p = &out[0];
+    *p++ = static_cast<char>(TAG_PACKET_STATE_PACKET);
+    p = putVarint(p, body);
+    p = putInt32Field(p, TAG_STATE, snap.state);
+    p = putInt32Field(p, TAG_TICK, snap.tick);
+    for (size_t k = 0; k < count; ++k) {
+        const PlayerFragment& f = fragments[slotIndexOf(snap.players[indices[k]].id)];
+        std::memcpy(p, f.bytes, FRAGMENT_BYTES);
+        p += f.len;
+    }
+    p = putUint32Field(p, TAG_SEQ, seq);
+    p = putUint32Field(p, TAG_BASELINE_SEQ, baseline);
+    if (removed_count) {
+        *p++ = static_cast<char>(TAG_REMOVED);
+        p = putVarint(p, removed_body);
+        for (size_t r = 0; r < removed_count; ++r) p = putInt32(p, removed_ids[r]);
+    }
+    p = putUint32Field(p, TAG_PART, part);
+    putUint32Field(p, TAG_PART_COUNT, part_count);
+    out.resize(total);
+}
+
+
+void SnapshotBroadcaster::beginPacket(EncodeContext& ctx, const WorldSnapshot& snap, uint32_t seq,
+                                      uint32_t baseline, uint32_t part, uint32_t part_count) {
+    StatePacket* sp = ctx.packet.mutable_state_packet();
+    sp->set_state(static_cast<::GameState>(snap.state));
+    sp->set_tick(snap.tick);
+    sp->set_seq(seq);
+    sp->set_baseline_seq(baseline);
+    sp->set_part(part);
+    sp->set_part_count(part_count);
+    // Clear() keeps the Player messages allocated for the next client.
+    sp->mutable_players()->Clear();
+    sp->mutable_removed()->Clear();
+    sp->mutable_packed_players()->clear();
+}
+
+SnapshotBroadcaster::PartRange SnapshotBroadcaster::encodeParts(EncodeContext& ctx, const WorldSnapshot& snap,
+                                                                uint32_t seq, uint32_t baseline, PlayerCodec codec,
+                                                                const uint32_t* indices, size_t count,
+                                                                const std::vector<int32_t>& removed_ids) {
+    const bool packed = codec == PLAYER_CODEC_PACKED;
+    PackedBounds bounds;
+    if (packed) {
+        PackedBoundsBuilder builder;
+        for (size_t k = 0; k < count; ++k) {
+            const SnapshotPlayer& p = snap.players[indices[k]];
+            builder.add(p.id, p.x, p.y);
+        }
+        bounds = builder.bounds();
+    }
+
+    // Pass 1: greedily cut the items (removed IDs, then players) into parts
+    // that fit the budget, counted in bits. An empty snapshot still gets one part.
+    const size_t nr = removed_ids.size();
+    const size_t total = nr + count;
+    const size_t budget = (packed ? PACKED_PART_BUDGET : PART_BUDGET) * 8;
+    std::vector<size_t>& partEnds = ctx.partEnds;
+    partEnds.clear();
+    size_t used = 0;
+    for (size_t j = 0; j < total; ++j) {
+        size_t size = j < nr ? CodedOutputStream::VarintSize32SignExtended(removed_ids[j]) * 8
+                      : packed ? bounds.playerBits()
+                               : fragments[slotIndexOf(snap.players[indices[j - nr]].id)].len * 8u;
+        if (used > 0 && used + size > budget) {
+            partEnds.push_back(j);
+            used = 0;
+        }
+        used += size;
+    }
+    partEnds.push_back(total);
+
+    // Pass 2: encode each part into the next pooled buffer.
+    PartRange range{ctx.index, ctx.partsUsed, partEnds.size()};
+    const uint32_t part_count = static_cast<uint32_t>(partEnds.size());
+    StatePacket* sp = ctx.packet.mutable_state_packet();
+    size_t begin = 0;
+    for (uint32_t part = 0; part < part_count; ++part) {
+        const size_t end = partEnds[part];
+        const size_t removed_end = std::min(end, nr);
+        const size_t first_player = std::max(begin, nr);
+        if (ctx.partsUsed == ctx.parts.size()) ctx.parts.emplace_back().reserve(SNAPSHOT_MTU_PAYLOAD + FRAGMENT_BYTES);
+        std::string& out = ctx.parts[ctx.partsUsed++];
+
+        if (packed) {
+            beginPacket(ctx, snap, seq, baseline, part, part_count);
+            for (size_t j = begin; j < removed_end; ++j) sp->add_removed(removed_ids[j]);
+            ctx.packer.begin(*sp->mutable_packed_players(), bounds, static_cast<uint32_t>(end - first_player));
+            for (size_t j = first_player; j < end; ++j) {
+                const SnapshotPlayer& p = snap.players[indices[j - nr]];
+                ctx.packer.add(p.id, p.x, p.y, p.blocked);
+            }
+            ctx.packer.finish();
+            ctx.packet.SerializeToString(&out);
+        } else {
+            // Splice the players' cached fragments instead of re-encoding them.
+            writeProtobufPart(out, snap, seq, baseline, part, part_count, removed_ids.data() + std::min(begin, nr),
+                              removed_end > begin ? removed_end - begin : 0,
+                              indices + (first_player - nr), end - first_player);
+        }
+        begin = end;
+    }
+    return range;
+}
+
+SnapshotBroadcaster::PartRange SnapshotBroadcaster::encodeFull(EncodeContext& ctx, const WorldSnapshot& snap,
+                                                               uint32_t seq, PlayerCodec codec,
+                                                               const uint32_t* indices, size_t count) {
+    ctx.removed.clear();
+    return encodeParts(ctx, snap, seq, 0, codec, indices, count, ctx.removed);
+}
+
+uint32_t SnapshotBroadcaster::nextStamp(EncodeContext& ctx) {
+    if (++ctx.stampValue == 0) {  // Wrapped: old marks could collide
+        std::fill(ctx.stamp.begin(), ctx.stamp.end(), 0);
+        ctx.stampValue = 1;
+    }
+    return ctx.stampValue;
+}
+
+void SnapshotBroadcaster::collectDelta(EncodeContext& ctx, const WorldSnapshot& snap, const SnapshotPlayer& viewer,
+                                       uint32_t seq, const uint32_t* indices, size_t count, const WorldFrame& base,
+                                       const int32_t* base_ids, size_t base_count,
+                                       const PendingEntry* base_pending, size_t pending_count) {
+    std::vector<uint32_t>& stamp = ctx.stamp;
+    std::vector<int32_t>& stampId = ctx.stampId;
+    std::vector<uint32_t>& changed = ctx.changed;
+    std::vector<int32_t>& removed = ctx.removed;
+
+    // Pass 1: mark what the client had (and what was held back from it),
+    // keep only what is new or changed and, with update tiers, due.
+    uint32_t had = nextStamp(ctx);
+    uint32_t lagging = nextStamp(ctx); // Held back by its tier: an older copy, but not waiting
+    uint32_t stale = nextStamp(ctx);   // Held, but an older copy
+    uint32_t absent = nextStamp(ctx);  // Visible, never delivered
+    for (size_t b = 0; b < base_count; ++b) {
+        int32_t id = base_ids[b];
+        const bool behind = id < 0;  // Stored as ~id (IDs are positive)
+        if (behind) id = ~id;
+        uint32_t slot = slotIndexOf(id);
+        stamp[slot] = behind ? lagging : had;
+        stampId[slot] = id;
+    }
+    for (size_t b = 0; b < pending_count; ++b) {
+        uint32_t slot = slotIndexOf(base_pending[b].id);
+        stamp[slot] = base_pending[b].held ? stale : absent;
+        stampId[slot] = base_pending[b].id;
+        ctx.stampSince[slot] = base_pending[b].since;
+    }
+    const bool tracked = clientBudget > 0 || !tiers.empty();
+    changed.clear();
+    ctx.changedSince.clear();
+    ctx.changedHeld.clear();
+    for (size_t k = 0; k < count; ++k) {
+        const SnapshotPlayer& p = snap.players[indices[k]];
+        uint32_t slot = slotIndexOf(p.id);
+        bool same = stampId[slot] == p.id;
+        bool unchanged = same && stamp[slot] == had &&
+                         base.slotX[slot] == p.x && base.slotY[slot] == p.y &&
+                         (base.slotBlocked[slot] != 0) == p.blocked;
+        if (unchanged) continue;
+        if (!tracked) {
+            changed.push_back(indices[k]);
+            continue;
+        }
+        const bool waiting = same && (stamp[slot] == stale || stamp[slot] == absent);
+        const bool held = same && (stamp[slot] == had || stamp[slot] == lagging || stamp[slot] == stale);
+        uint32_t since = waiting ? ctx.stampSince[slot] : seq;
+        uint32_t held_since = seq;
+        if (held && !tiers.empty() && p.id != viewer.id && !isTierDue(viewer, p, seq, seq - base.seq, held_since)) {
+            // The client keeps its older copy until this player's tier is due:
+            // marked in the sent IDs, or kept pending if the budget already
+            // had it waiting, so that the wait carries.
+            if (waiting) {
+                deferPlayer(ctx, p.id, since, true, seq);
+            } else {
+                ctx.tierSkipped.push_back(static_cast<uint32_t>(k));
+            }
+            ctx.stats.tierSkipped++;
+            continue;
+        }
+        if (stamp[slot] == lagging) since = held_since;
+        changed.push_back(indices[k]);
+        ctx.changedSince.push_back(since);
+        ctx.changedHeld.push_back(held);
+    }
+
+    // Pass 2: mark what the client has now, collect held players that left.
+    // Players kept pending above keep their mark, for the sent IDs.
+    uint32_t has = nextStamp(ctx);
+    const uint32_t kept = ctx.pendingStamp;
+    for (size_t k = 0; k < count; ++k) {
+        uint32_t slot = slotIndexOf(snap.players[indices[k]].id);
+        if (kept && stamp[slot] == kept) continue;
+        stamp[slot] = has;
+        stampId[slot] = snap.players[indices[k]].id;
+    }
+    auto present = [&](int32_t id) {
+        const uint32_t slot = slotIndexOf(id);
+        return stampId[slot] == id && (stamp[slot] == has || (kept && stamp[slot] == kept));
+    };
+    removed.clear();
+    for (size_t b = 0; b < base_count; ++b) {
+        int32_t id = base_ids[b] < 0 ? ~base_ids[b] : base_ids[b];
+        if (!present(id)) removed.push_back(id);
+    }
+    for (size_t b = 0; b < pending_count; ++b) {
+        int32_t id = base_pending[b].id;
+        if (base_pending[b].held && !present(id)) removed.push_back(id);
+    }
+}
+
+void SnapshotBroadcaster::deferPlayer(EncodeContext& ctx, int32_t id, uint32_t since, bool held, uint32_t seq) {
+    if (ctx.pendingStamp == 0) ctx.pendingStamp = nextStamp(ctx);
+    ctx.pending[seq % WINDOW].push_back(PendingEntry{id, since, held});
+    ctx.stamp[slotIndexOf(id)] = ctx.pendingStamp;
+    ctx.stampId[slotIndexOf(id)] = id;
+}
+
+void SnapshotBroadcaster::carryWaits(EncodeContext& ctx, const ClientView& view, uint32_t seq) {
+    // Full snapshots have no baseline to carry waits from: take them from
+    // the newest snapshot this client was sent, acked or not.
+    ctx.changedSince.assign(ctx.changed.size(), seq);
+    for (uint32_t back = 1; back < WINDOW && back < seq; ++back) {
+        const uint32_t prev = seq - back, k = prev % WINDOW;
+        if (view.seqs[k] != prev || frames[k].seq != prev) continue;
+        if (view.pendingCount[k] == 0) return;
+        const PendingEntry* entries = contexts[view.sentContext[k]]->pending[k].data() + view.pendingStart[k];
+        uint32_t waiting = nextStamp(ctx);
+        for (size_t e = 0; e < view.pendingCount[k]; ++e) {
+            uint32_t slot = slotIndexOf(entries[e].id);
+            ctx.stamp[slot] = waiting;
+            ctx.stampId[slot] = entries[e].id;
+            ctx.stampSince[slot] = entries[e].since;
+        }
+        const WorldSnapshot& snap = *current;
+        for (size_t c = 0; c < ctx.changed.size(); ++c) {
+            const int32_t id = snap.players[ctx.changed[c]].id;
+            uint32_t slot = slotIndexOf(id);
+            if (ctx.stamp[slot] == waiting && ctx.stampId[slot] == id) ctx.changedSince[c] = ctx.stampSince[slot];
+        }
+        return;
+    }
+}
+
+bool SnapshotBroadcaster::isTierDue(const SnapshotPlayer& viewer, const SnapshotPlayer& p, uint32_t seq, uint32_t gap,
+                                    uint32_t& held_since) const {
+    const int64_t dx = int64_t(p.x) - viewer.x, dy = int64_t(p.y) - viewer.y;
+    const int64_t d2 = dx * dx + dy * dy;
+    size_t t = 0;
+    while (t + 1 < tiers.size() && d2 > int64_t(tiers[t].radius) * tiers[t].radius) ++t;
+    // A player held back by its tier has waited since just after the due
+    // snapshot before its latest one; the budget ranks it by that.
+    const uint32_t phase = tierPhase[slotIndexOf(p.id) * tiers.size() + t];
+    held_since = seq - std::min(phase + tiers[t].interval - 1, seq);
+    // Due if any due snapshot falls after the baseline: one the client has
+    // not acked may never arrive, so it is repeated until the baseline has it.
+    return phase < gap;
+}
+
+size_t SnapshotBroadcaster::applyBudget(EncodeContext& ctx, const WorldSnapshot& snap, const SnapshotPlayer& viewer,
+                                        const WorldFrame* base, uint32_t seq, PlayerCodec codec) {
+    std::vector<uint32_t>& changed = ctx.changed;
+    const size_t count = changed.size();
+    const bool packed = codec == PLAYER_CODEC_PACKED;
+
+    // What the players may take: the budget minus removed IDs and the
+    // headers of as many parts as the budget spans.
+    const size_t parts = (clientBudget + SNAPSHOT_MTU_PAYLOAD - 1) / SNAPSHOT_MTU_PAYLOAD;
+    size_t overhead = parts * (PART_HEADER_BYTES + (packed ? PART_BUDGET - PACKED_PART_BUDGET : 0));
+    for (int32_t id : ctx.removed) overhead += int32Size(id);
+    const size_t avail = clientBudget > overhead ? (clientBudget - overhead) * 8 : 0;
+
+    size_t player_bits = 0;
+    if (packed) {
+        PackedBoundsBuilder builder;
+        for (uint32_t idx : changed) builder.add(snap.players[idx].id, snap.players[idx].x, snap.players[idx].y);
+        player_bits = builder.bounds().playerBits();  // A subset's bounds can only be tighter
+    }
+    auto bits = [&](uint32_t idx) {
+        return packed ? player_bits : fragments[slotIndexOf(snap.players[idx].id)].len * size_t(8);
+    };
+    size_t total = 0;
+    for (uint32_t idx : changed) total += bits(idx);
+    if (total <= avail) return count;
+
+    // Over budget: rank every candidate and send the best that fit.
+    const float scale = PRIORITY_DISTANCE_SCALE;
+    ctx.ranked.resize(count);
+    for (size_t c = 0; c < count; ++c) {
+        const SnapshotPlayer& p = snap.players[changed[c]];
+        const uint32_t slot = slotIndexOf(p.id);
+        const float dx = float(p.x) - viewer.x, dy = float(p.y) - viewer.y;
+        const float nearness = scale * scale / (scale * scale + dx * dx + dy * dy);
+        float moved = scale;  // Unknown to the client: as urgent as a large move
+        if (base && slot < base->slotId.size() && base->slotId[slot] == p.id) {
+            moved = std::abs(float(p.x) - base->slotX[slot]) + std::abs(float(p.y) - base->slotY[slot]);
+        }
+        const uint32_t since = ctx.changedSince.empty() ? seq : ctx.changedSince[c];
+        Candidate& cand = ctx.ranked[c];
+        cand.index = changed[c];
+        cand.since = since;
+        cand.held = !ctx.changedHeld.empty() && ctx.changedHeld[c];
+        cand.priority = float(1 + seq - since) * (nearness + moved / (scale + moved));
+    }
+    std::sort(ctx.ranked.begin(), ctx.ranked.end(), [](const Candidate& a, const Candidate& b) {
+        return a.priority != b.priority ? a.priority > b.priority : a.index < b.index;
+    });
+
+    // Greedy fill; the top candidate always goes so nothing can starve forever.
+    size_t used = 0;
+    size_t chosen = 0;
+    for (const Candidate& cand : ctx.ranked) {
+        const size_t b = bits(cand.index);
+        if (chosen == 0 || used + b <= avail) {
+            changed[chosen++] = cand.index;
+            used += b;
+            continue;
+        }
+        deferPlayer(ctx, snap.players[cand.index].id, cand.since, cand.held, seq);
+        ctx.stats.maxUnsentTicks = std::max<uint64_t>(ctx.stats.maxUnsentTicks, 1 + seq - cand.since);
+    }
+    changed.resize(chosen);
+    ctx.stats.budgetLimited++;
+    ctx.stats.deferred += count - chosen;
+    return chosen;
+}
+
+void SnapshotBroadcaster::queueParts(Transport& transport, const sockaddr_in& addr, PartRange range) {
+    const std::deque<std::string>& parts = contexts[range.context]->parts;
+    for (size_t p = range.first; p < range.first + range.count; ++p) {
+        transport.queue(addr, parts[p].data(), parts[p].size());
+    }
+}
+
+uint64_t SnapshotBroadcaster::partsBytes(PartRange range) const {
+    const std::deque<std::string>& parts = contexts[range.context]->parts;
+    uint64_t size = 0;
+    for (size_t p = range.first; p < range.first + range.count; ++p) size += parts[p].size();
+    return size;
+}
+
+uint64_t SnapshotBroadcaster::partsOverMtu(PartRange range) const {
+    const std::deque<std::string>& parts = contexts[range.context]->parts;
+    uint64_t over = 0;
+    for (size_t p = range.first; p < range.first + range.count; ++p) over += parts[p].size() > SNAPSHOT_MTU_PAYLOAD;
+    return over;
+}
+
+void SnapshotBroadcaster::recordFrame(const WorldSnapshot& snap, uint32_t seq) {
+    WorldFrame& frame = frames[seq % WINDOW];
+    for (int32_t id : frame.ids) frame.slotId[slotIndexOf(id)] = 0;
+    frame.ids.clear();
+    frame.seq = seq;
+    for (auto& ctx : contexts) {
+        ctx->sent[seq % WINDOW].clear();
+        ctx->sent[seq % WINDOW].reserve(ctx->sentCapacity);  // Grow every ring slot together, not one per tick
+        ctx->pending[seq % WINDOW].clear();
+        ctx->pending[seq % WINDOW].reserve(ctx->pendingCapacity);
+    }
+
+    for (const SnapshotPlayer& p : snap.players) {
+        uint32_t slot = slotIndexOf(p.id);
+        if (slot >= frame.slotId.size()) {
+            size_t size = slot + 1;
+            frame.slotId.resize(size, 0);
+            frame.slotX.resize(size);
+            frame.slotY.resize(size);
+            frame.slotBlocked.resize(size);
+        }
+        frame.ids.push_back(p.id);
+        frame.slotId[slot] = p.id;
+        frame.slotX[slot] = p.x;
+        frame.slotY[slot] = p.y;
+        frame.slotBlocked[slot] = p.blocked;
+    }
+    for (auto& ctx : contexts) {
+        if (ctx->stamp.size() < frame.slotId.size()) {
+            ctx->stamp.resize(frame.slotId.size(), 0);
+            ctx->stampId.resize(frame.slotId.size(), 0);
+            ctx->stampSince.resize(frame.slotId.size(), 0);
+        }
+    }
+}
+
+SnapshotBroadcaster::ClientView& SnapshotBroadcaster::viewFor(int id) {
+    uint32_t slot = slotIndexOf(id);
+    if (slot >= views.size()) views.resize(slot + 1);
+    ClientView& view = views[slot];
+    if (view.id != id) {
+        view.id = id;
+        std::fill(std::begin(view.seqs), std::end(view.seqs), 0u);
+    }
+    return view;
+}
+
+const SnapshotBroadcaster::WorldFrame* SnapshotBroadcaster::baselineFor(const ClientView& view, uint32_t ack,
+                                                                        uint32_t seq) const {
+    if (ack == 0 || ack >= seq || seq - ack >= WINDOW) return nullptr;  // None, bogus or too old
+    uint32_t k = ack % WINDOW;
+    if (view.seqs[k] != ack || frames[k].seq != ack) return nullptr;  // Not sent to this client
+    return &frames[k];
+}
+
+void SnapshotBroadcaster::encodeClient(EncodeContext& ctx, size_t i) {
+    const WorldSnapshot& snap = *current;
+    const uint32_t seq = currentSeq;
+    const size_t n = snap.players.size();
+    const SnapshotPlayer& player = snap.players[i];
+    const uint32_t* shown = everyone.data();
+    size_t shown_count = n;
+    if (interestRadius > 0) {
+        ctx.visible.clear();
+        grid.query(player.x, player.y, ctx.visible);
+        shown = ctx.visible.data();
+        shown_count = ctx.visible.size();
+    }
+
+    // Sized by broadcast(), and no other worker touches this client's slot.
+    ClientView& view = views[slotIndexOf(player.id)];
+    const WorldFrame* base = baselineFor(view, player.ack, seq);
+    const PlayerCodec codec = player.codec;
+    const uint32_t k = seq % WINDOW;
+    std::vector<PendingEntry>& pending = ctx.pending[k];
+    const size_t pending_start = pending.size();
+    ctx.pendingStamp = 0;
+    ctx.tierSkipped.clear();
+    PartRange range = fullState;  // Same bytes for every client without a baseline
+    bool shared = true;
+    size_t encoded = shown_count;
+    if (base) {
+        const uint32_t bk = base->seq % WINDOW;
+        const EncodeContext& owner = *contexts[view.sentContext[bk]];
+        const int32_t* base_ids = view.wholeWorld[bk] ? base->ids.data() : owner.sent[bk].data() + view.sentStart[bk];
+        size_t base_count = view.wholeWorld[bk] ? base->ids.size() : view.sentCount[bk];
+        const PendingEntry* base_pending = owner.pending[bk].data() + view.pendingStart[bk];
+        collectDelta(ctx, snap, player, seq, shown, shown_count, *base, base_ids, base_count, base_pending,
+                     view.wholeWorld[bk] ? 0 : view.pendingCount[bk]);
+        encoded = clientBudget ? applyBudget(ctx, snap, player, base, seq, codec) : ctx.changed.size();
+        range = encodeParts(ctx, snap, seq, base->seq, codec, ctx.changed.data(), encoded, ctx.removed);
+        shared = false;
+        ctx.stats.deltas++;
+    } else if (interestRadius > 0 || (clientBudget && (codec == PLAYER_CODEC_PACKED ? fullPackedSize : fullStateSize) >
+                                                          clientBudget)) {
+        if (clientBudget) {
+            ctx.changed.assign(shown, shown + shown_count);
+            carryWaits(ctx, view, seq);
+            ctx.changedHeld.clear();
+            ctx.removed.clear();
+            encoded = applyBudget(ctx, snap, player, nullptr, seq, codec);
+            range = encodeFull(ctx, snap, seq, codec, ctx.changed.data(), encoded);
+        } else {
+            range = encodeFull(ctx, snap, seq, codec, shown, shown_count);
+        }
+        shared = false;
+    } else if (codec == PLAYER_CODEC_PACKED) {
+        range = fullPacked;
+    }
+    if (codec == PLAYER_CODEC_PACKED) ctx.stats.packed++;
+
+    // Remember what this client now has, for future deltas: the visible
+    // players except those the budget deferred, which are kept as pending,
+    // with the ones held back by their tier stored as ~id.
+    const size_t deferred = pending.size() - pending_start;
+    view.seqs[k] = seq;
+    view.wholeWorld[k] = interestRadius <= 0 && deferred == 0 && ctx.tierSkipped.empty();
+    view.sentContext[k] = ctx.index;
+    view.pendingStart[k] = static_cast<uint32_t>(pending_start);
+    view.pendingCount[k] = static_cast<uint32_t>(deferred);
+    if (!view.wholeWorld[k]) {
+        std::vector<int32_t>& sent = ctx.sent[k];
+        view.sentStart[k] = static_cast<uint32_t>(sent.size());
+        const uint32_t* skip = ctx.tierSkipped.data();
+        const uint32_t* skip_end = skip + ctx.tierSkipped.size();
+        const bool cuts = ctx.pendingStamp != 0;
+        for (size_t v = 0; v < shown_count; ++v) {
+            const int32_t id = snap.players[shown[v]].id;
+            if (skip != skip_end && *skip == v) {
+                sent.push_back(~id);
+                ++skip;
+                continue;
+            }
+            if (cuts && ctx.stamp[slotIndexOf(id)] == ctx.pendingStamp && ctx.stampId[slotIndexOf(id)] == id) continue;
+            sent.push_back(id);
+        }
+        view.sentCount[k] = static_cast<uint32_t>(sent.size() - view.sentStart[k]);
+    }
+    clientParts[i] = range;
+
+    // Only this worker's own parts may be read here: the shared full-world
+    // parts live in context 0, which worker 0 may be appending to meanwhile.
+    uint64_t size = 0;
+    if (shared) {
+        const bool packed = codec == PLAYER_CODEC_PACKED;
+        size = packed ? fullPackedSize : fullStateSize;
+        ctx.stats.overMtu += packed ? fullPackedOverMtu : fullStateOverMtu;
+    } else {
+        for (size_t p = range.first; p < range.first + range.count; ++p) {
+            size += ctx.parts[p].size();
+            if (ctx.parts[p].size() > SNAPSHOT_MTU_PAYLOAD) ctx.stats.overMtu++;
+        }
+    }
+    ctx.stats.snapshots++;
+    ctx.stats.parts += range.count;
+    ctx.stats.bytes += size;
+    ctx.stats.visible += shown_count;
+    ctx.stats.encoded += encoded;
+    if (size < ctx.stats.minBytes) ctx.stats.minBytes = size;
+    if (size > ctx.stats.maxBytes) ctx.stats.maxBytes = size;
+}
+
+void SnapshotBroadcaster::mergeStats(const BroadcastStats& from) {
+    stats.snapshots += from.snapshots;
+    stats.parts += from.parts;
+    stats.bytes += from.bytes;
+    stats.minBytes = std::min(stats.minBytes, from.minBytes);
+    stats.maxBytes = std::max(stats.maxBytes, from.maxBytes);
+    stats.visible += from.visible;
+    stats.encoded += from.encoded;
+    stats.deltas += from.deltas;
+    stats.packed += from.packed;
+    stats.overMtu += from.overMtu;
+    stats.budgetLimited += from.budgetLimited;
+    stats.deferred += from.deferred;
+    stats.maxUnsentTicks = std::max(stats.maxUnsentTicks, from.maxUnsentTicks);
+    stats.tierSkipped += from.tierSkipped;
+}
+
+void SnapshotBroadcaster::broadcast(const WorldSnapshot& snap, Transport& transport, const sockaddr_in& viewer) {
+    const size_t n = snap.players.size();
+    const uint32_t seq = static_cast<uint32_t>(snap.sequence);
+    for (auto& ctx : contexts) ctx->partsUsed = 0;
+
+    // Serial part: everything the workers share is built here and only read below.
+    recordFrame(snap, seq);
+    refreshFragments(snap);
+    for (const SnapshotPlayer& p : snap.players) viewFor(p.id);
+    everyone.resize(n);
+    std::iota(everyone.begin(), everyone.end(), 0u);
+    EncodeContext& main = *contexts[0];
+    fullState = encodeFull(main, snap, seq, PLAYER_CODEC_PROTOBUF, everyone.data(), n);
+    if (interestRadius <= 0) {
+        bool any_packed = false;
+        for (const SnapshotPlayer& p : snap.players) any_packed |= p.codec == PLAYER_CODEC_PACKED;
+        if (any_packed) fullPacked = encodeFull(main, snap, seq, PLAYER_CODEC_PACKED, everyone.data(), n);
+        fullPackedSize = any_packed ? partsBytes(fullPacked) : 0;
+        fullPackedOverMtu = any_packed ? partsOverMtu(fullPacked) : 0;
+    }
+    fullStateSize = partsBytes(fullState);
+    fullStateOverMtu = partsOverMtu(fullState);
+
+    // How long ago each tier was last due for each player, staggered by slot
+    // so that a slow tier's players do not all go out on the same tick.
+    if (!tiers.empty()) {
+        tierPhase.resize(fragments.size() * tiers.size());
+        for (const SnapshotPlayer& p : snap.players) {
+            const uint32_t slot = slotIndexOf(p.id);
+            for (size_t t = 0; t < tiers.size(); ++t) tierPhase[slot * tiers.size() + t] = (seq + slot) % tiers[t].interval;
+        }
+    }
+
+    if (interestRadius > 0) {
+        xs.resize(n);
+        ys.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            xs[i] = snap.players[i].x;
+            ys[i] = snap.players[i].y;
+        }
+        grid.build(xs.data(), ys.data(), n, interestRadius);
+    }
+
+    // Parallel part: each worker encodes its share of the clients into its own context.
+    current = &snap;
+    currentSeq = seq;
+    clientParts.resize(n);
+    auto t0 = std::chrono::steady_clock::now();
+    pool.run(n, ENCODE_GRAIN, [this](unsigned worker, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) encodeClient(*contexts[worker], i);
+    });
+    stats.encodeNs += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::steady_clock::now() - t0).count();
+    current = nullptr;
+
+    for (auto& ctx : contexts) {
+        mergeStats(ctx->stats);
+        ctx->stats = BroadcastStats{};
+        ctx->sentCapacity = std::max(ctx->sentCapacity, ctx->sent[seq % WINDOW].capacity());
+        ctx->pendingCapacity = std::max(ctx->pendingCapacity, ctx->pending[seq % WINDOW].capacity());
+    }
+    for (unsigned w = 0; w < pool.size(); ++w) {
+        stats.workerBusyNs[w] += pool.getBusyNs(w);
+        stats.workerSteals[w] += pool.getSteals(w);
+    }
+    pool.resetCounters();
+
+    // Sending stays on this thread, in client order.
+    transport.beginTick();
+    for (size_t i = 0; i < n; ++i) queueParts(transport, snap.players[i].addr, clientParts[i]);
+    // The local viewer GUI mirrors the whole world.
+    queueParts(transport, viewer, fullState);
+    transport.flush();
+
+    stats.broadcasts++;
+    stats.fullStateBytes += fullStateSize;
+}
+
+void SnapshotBroadcaster::logAndResetStats() {
+    if (stats.snapshots == 0) return;
+
+    std::cout << "[STATS] snapshots aoi_radius=" << interestRadius
+              << " per_client_bytes avg=" << stats.bytes / stats.snapshots
+              << " min=" << stats.minBytes
+              << " max=" << stats.maxBytes
+              << " avg_visible=" << stats.visible / stats.snapshots
+              << " avg_encoded=" << stats.encoded / stats.snapshots
+              << " avg_parts=" << double(stats.parts) / stats.snapshots
+              << " delta=" << stats.deltas << "/" << stats.snapshots
+              << " packed=" << stats.packed << "/" << stats.snapshots
+              << " reencoded_per_broadcast=" << stats.reencoded / stats.broadcasts
+              << " over_mtu=" << stats.overMtu
+              << " budget=" << clientBudget
+              << " budget_limited=" << stats.budgetLimited << "/" << stats.snapshots
+              << " deferred_per_snapshot=" << double(stats.deferred) / stats.snapshots
+              << " max_unsent_ticks=" << stats.maxUnsentTicks
+              << " update_tiers=" << tiers.size()
+              << " tier_skipped_per_snapshot=" << double(stats.tierSkipped) / stats.snapshots
+              << " full_state_bytes=" << stats.fullStateBytes / stats.broadcasts << std::endl;
+
+    std::cout << "[STATS] encode_workers=" << pool.size()
+              << " encode_ms_per_broadcast=" << stats.encodeNs / 1e6 / stats.broadcasts
+              << " busy_ms_per_broadcast=";
+    for (unsigned w = 0; w < pool.size(); ++w) {
+        std::cout << (w ? "/" : "") << stats.workerBusyNs[w] / 1e6 / stats.broadcasts;
+    }
+    std::cout << " steals=";
+    for (unsigned w = 0; w < pool.size(); ++w) std::cout << (w ? "/" : "") << stats.workerSteals[w];
+    std::cout << std::endl;
+
+    stats = BroadcastStats{};
+}
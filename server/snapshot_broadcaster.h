@@ -0,0 +1,331 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+#include <netinet/in.h>
+#include "interest_grid.h"
+#include "transport.h"
+#include "worker_pool.h"
+#include "world_snapshot.h"
+#include "../common/player_codec.h"
+#include "../common/config.h"
+#include "../generated/game.pb.h"
+
+/**
+ * @brief Update rate for remote players within one distance band of a viewer.
+ */
+struct UpdateTier {
+    int radius = 0;         ///< Band ends at this distance (0 = unbounded, last tier only)
+    unsigned interval = 1;  ///< Send changes every this many snapshots
+};
+
+constexpr size_t MAX_UPDATE_TIERS = 8;
+constexpr double MIN_UPDATE_TIER_HZ = 1.0 / 3600;  ///< Slowest rate accepted: once an hour
+
+/**
+ * @brief Parses "R1:HZ1,R2:HZ2,...,HZ" (radii ascending; the last rate has
+ * no radius and covers everything farther) into tiers, converting rates to
+ * snapshot intervals at 1000 / BROADCAST_INTERVAL_MS snapshots per second.
+ * An empty spec gives no tiers; at most MAX_UPDATE_TIERS are accepted.
+ * Rates below MIN_UPDATE_TIER_HZ and radii above PROXIMITY_MAX_RADIUS (the
+ * largest interest radius) are rejected.
+ */
+bool parseUpdateTiers(const std::string& spec, std::vector<UpdateTier>& tiers);
+
+/**
+ * @brief Per-client snapshot size counters kept by SnapshotBroadcaster.
+ */
+struct BroadcastStats {
+    uint64_t broadcasts = 0;       ///< Snapshots broadcast
+    uint64_t snapshots = 0;        ///< Per-client snapshots encoded
+    uint64_t parts = 0;            ///< Datagrams those snapshots were split into
+    uint64_t bytes = 0;            ///< Sum of per-client snapshot sizes (all parts)
+    uint64_t minBytes = UINT64_MAX;
+    uint64_t maxBytes = 0;
+    uint64_t visible = 0;          ///< Sum of players visible to each client
+    uint64_t encoded = 0;          ///< Sum of players actually written (deltas skip unchanged ones)
+    uint64_t deltas = 0;           ///< Client packets encoded against an acknowledged baseline
+    uint64_t packed = 0;           ///< Client snapshots sent with PLAYER_CODEC_PACKED
+    uint64_t reencoded = 0;        ///< Player fragments rebuilt because the player changed
+    uint64_t overMtu = 0;          ///< Datagrams larger than SNAPSHOT_MTU_PAYLOAD (should stay 0)
+    uint64_t budgetLimited = 0;    ///< Client snapshots that hit the byte budget and deferred players
+    uint64_t deferred = 0;         ///< Sum of players deferred to a later snapshot by the budget
+    uint64_t maxUnsentTicks = 0;   ///< Longest a changed player waited unsent for one client (starvation)
+    uint64_t tierSkipped = 0;      ///< Changed players held back because their update tier was not due
+    uint64_t fullStateBytes = 0;   ///< Sum of full-world snapshot sizes (what every client got before)
+    uint64_t encodeNs = 0;         ///< Wall time of the per-client encode phase
+    uint64_t workerBusyNs[MAX_ENCODE_WORKERS] = {};  ///< Time each encode worker spent encoding clients
+    uint64_t workerSteals[MAX_ENCODE_WORKERS] = {};  ///< Client chunks each worker stole from another
+};
+
+/**
+ * @brief Encodes a WorldSnapshot per client and hands the packets to a Transport.
+ *
+ * With a positive interest radius each client only receives the players
+ * within that radius of itself (area of interest), found through an
+ * InterestGrid built once per broadcast; with radius 0 everyone receives
+ * the full world. The viewer address (GUI) always gets the full world.
+ *
+ * Clients that acknowledge snapshots (ack_seq in Ping/ClientUpdate) get
+ * deltas: only players whose fields changed since the acknowledged
+ * snapshot, plus the IDs that left their view. The broadcaster keeps the
+ * last DELTA_BASELINE_WINDOW world states and, per client, which players
+ * each of its snapshots contained; if the acknowledged snapshot has fallen
+ * out of that window (or the client never acked) a full snapshot is sent.
+ *
+ * Every snapshot is split into datagrams of at most SNAPSHOT_MTU_PAYLOAD
+ * bytes, each a self-contained StatePacket carrying a subset of the
+ * players plus its part index and the part count, so losing one part only
+ * loses those players. A delta's removed IDs travel in the leading parts.
+ *
+ * Clients that negotiated PLAYER_CODEC_PACKED get their players as one
+ * bit-packed block per part (packed_players) instead of Player messages;
+ * the block's bounds cover the whole snapshot so every part has the same
+ * per-player width.
+ *
+ * Protobuf-codec parts are not built through a Packet: every player's
+ * encoded `players` entry is cached per slot and rebuilt only when the
+ * player's position or blocked flag changes, and each part is written by
+ * splicing those fragments between hand-encoded header fields (the same
+ * bytes SerializeToString() would produce). Encoding work is thus
+ * proportional to movers, and copying to the number of players sent.
+ *
+ * With a per-client byte budget, a snapshot whose players do not fit is
+ * filled by priority instead: each candidate (new or changed player) scores
+ * (1 + ticks it has been waiting) * (nearness + movement), nearness and
+ * movement both in [0, 1] relative to PRIORITY_DISTANCE_SCALE, so close and
+ * fast-moving players go first and everything deferred gains priority
+ * every tick until it is sent. Deferred players are remembered with the
+ * snapshot (PendingEntry) so their wait carries over to the next delta;
+ * a client that still holds an older copy keeps it and is treated as
+ * having changed. Removed IDs are always sent. Waits are tracked along
+ * the chain of acknowledged baselines, so a client that acks late sees
+ * them restart from its baseline. A client without a usable baseline
+ * (it never acks, or its ack fell out of the window) gets full snapshots,
+ * whose waits carry over from the previous snapshot it was sent instead,
+ * so deferred players still gain priority and cannot starve.
+ *
+ * With update tiers, a changed remote player the client already holds is
+ * only sent on snapshots its tier is due for, the tier being picked by its
+ * distance to that viewer (e.g. 10 Hz near, 5 Hz mid, 1 Hz far). Due
+ * snapshots are staggered by player slot so the far tier does not land
+ * on one tick. A player is due if any of its due snapshots is newer than
+ * the client's baseline, so a due update in a snapshot that was not acked
+ * is repeated until it is. Skipped players stay in the client's sent IDs,
+ * marked as held at an older state (~id), and go out on the next due
+ * snapshot with their latest state; one the budget already had waiting is
+ * kept pending instead, so its wait carries.
+ * The client's own player, new players and removals are never delayed,
+ * and full snapshots carry everyone.
+ *
+ * Clients are encoded in parallel on a WorkerPool (encode_workers, the
+ * broadcast thread being one of them). Shared state (frames, fragments, the
+ * grid, the full-world parts) is prepared serially first and only read
+ * while encoding; each worker writes into its own EncodeContext, and a
+ * client's view is only touched by the worker encoding it. The parts are
+ * then queued in client order on the broadcast thread, since a Transport
+ * is not thread-safe.
+ *
+ * Runs on the broadcast thread. The Packets, their Player messages, the
+ * encoded parts and every scratch array are reused between calls, so once
+ * they have grown to the largest snapshot a broadcast does no heap
+ * allocation (server_bench counts them).
+ */
+class SnapshotBroadcaster {
+public:
+    /**
+     * @param interest_radius Area-of-interest radius; 0 sends the full world to everyone.
+     * @param encode_workers Threads encoding clients, including the caller (1 = serial).
+     * @param client_budget Bytes each client may be sent per snapshot; 0 = unlimited.
+     * @param update_tiers Distance-based update rates; empty = every snapshot.
+     */
+    explicit SnapshotBroadcaster(int interest_radius, unsigned encode_workers = ENCODE_WORKERS,
+                                 size_t client_budget = CLIENT_SNAPSHOT_BUDGET,
+                                 std::vector<UpdateTier> update_tiers = {});
+
+    /**
+     * @brief Encodes and queues one packet per player plus one for `viewer`, then flushes.
+     */
+    void broadcast(const WorldSnapshot& snap, Transport& transport, const sockaddr_in& viewer);
+
+    int getInterestRadius() const { return interestRadius; }
+    unsigned getEncodeWorkers() const { return pool.size(); }
+    size_t getClientBudget() const { return clientBudget; }
+    const std::vector<UpdateTier>& getUpdateTiers() const { return tiers; }
+    const BroadcastStats& getStats() const { return stats; }
+
+    /**
+     * @brief Prints per-client snapshot size stats and resets them.
+     */
+    void logAndResetStats();
+
+private:
+    static constexpr uint32_t WINDOW = DELTA_BASELINE_WINDOW;
+    // Largest players entry: tag + length + id (1 + 5; IDs are positive)
+    // + x and y (1 + 10 each; negatives are sign-extended) + blocked (2).
+    static constexpr size_t MAX_FRAGMENT_LEN = 1 + 1 + (1 + 5) + (1 + 10) + (1 + 10) + 2;
+    static constexpr size_t FRAGMENT_BYTES = 32;  ///< Fragments are copied whole, then the tail is overwritten
+    static_assert(FRAGMENT_BYTES >= MAX_FRAGMENT_LEN, "a player fragment must fit its buffer");
+
+    /**
+     * World state of one broadcast snapshot, indexed by player ID slot.
+     */
+    struct WorldFrame {
+        uint32_t seq = 0;
+        std::vector<int32_t> ids;        ///< Players in the frame
+        std::vector<int32_t> slotId;     ///< ID occupying each slot in this frame (0 = none)
+        std::vector<int32_t> slotX;
+        std::vector<int32_t> slotY;
+        std::vector<uint8_t> slotBlocked;
+    };
+
+    /**
+     * What one client was sent in each of its recent snapshots.
+     */
+    struct ClientView {
+        int id = 0;                              ///< Owner; a new ID in the slot resets the view
+        uint32_t seqs[WINDOW] = {};              ///< Snapshot seq stored in each ring position
+        bool wholeWorld[WINDOW] = {};            ///< Snapshot had every player (ids not stored)
+        uint32_t sentContext[WINDOW] = {};       ///< EncodeContext whose `sent` holds this client's IDs
+        uint32_t sentStart[WINDOW] = {};         ///< Offset of those IDs in it (~id: held at an older state)
+        uint32_t sentCount[WINDOW] = {};
+        uint32_t pendingStart[WINDOW] = {};      ///< Players deferred by the budget, in the same context
+        uint32_t pendingCount[WINDOW] = {};
+    };
+
+    /**
+     * A visible player the budget kept out of one client snapshot.
+     */
+    struct PendingEntry {
+        int32_t id = 0;
+        uint32_t since = 0;   ///< Seq of the first snapshot that deferred it
+        bool held = false;    ///< Client still holds an older copy (otherwise it has none)
+    };
+
+    /**
+     * Budget candidate: a player that could go into the current snapshot.
+     */
+    struct Candidate {
+        float priority = 0;
+        uint32_t index = 0;   ///< Into snap.players
+        uint32_t since = 0;
+        bool held = false;
+    };
+
+    void recordFrame(const WorldSnapshot& snap, uint32_t seq);
+    ClientView& viewFor(int id);
+    const WorldFrame* baselineFor(const ClientView& view, uint32_t ack, uint32_t seq) const;
+    /**
+     * One player's encoded StatePacket.players entry (tag, length, Player)
+     * and the field values it was encoded from.
+     */
+    struct PlayerFragment {
+        int32_t id = 0;
+        int32_t x = 0;
+        int32_t y = 0;
+        bool blocked = false;
+        uint8_t len = 0;    ///< Encoded bytes (0 = never encoded)
+        char bytes[FRAGMENT_BYTES];  ///< Up to MAX_FRAGMENT_LEN (32) used
+    };
+
+    /**
+     * Encoded datagrams of one snapshot: contexts[context]->parts[first, first + count).
+     */
+    struct PartRange {
+        uint32_t context = 0;
+        size_t first = 0;
+        size_t count = 0;
+    };
+
+    /**
+     * Everything one encode worker writes, so workers share no mutable state.
+     * Reused between broadcasts.
+     */
+    struct EncodeContext {
+        uint32_t index = 0;                ///< Position in `contexts`
+        Packet packet;
+        PackedPlayerEncoder packer;
+        std::vector<uint32_t> visible;
+        std::vector<uint32_t> changed;     ///< Delta: indices of players to write
+        std::vector<uint32_t> changedSince;  ///< Budget: wait start of each changed player
+        std::vector<uint8_t> changedHeld;    ///< Budget: client holds an older copy of it
+        std::vector<Candidate> ranked;       ///< Budget: candidates sorted by priority
+        std::vector<int32_t> removed;      ///< Delta: baseline IDs no longer visible
+        std::vector<size_t> partEnds;      ///< Item index where each part ends (removed IDs first, then players)
+        std::vector<uint32_t> stamp;       ///< Per-slot membership marks for delta encoding
+        std::vector<int32_t> stampId;
+        std::vector<uint32_t> stampSince;  ///< Budget: wait start of a baseline's pending players, by slot
+        uint32_t stampValue = 0;
+        uint32_t pendingStamp = 0;         ///< Marks players kept pending for the current client (0 = none)
+        std::vector<uint32_t> tierSkipped; ///< Positions in the current client's visible list held back by their tier
+        std::deque<std::string> parts;     ///< Encoded datagrams; must live until flush(), deque keeps them in place
+        size_t partsUsed = 0;              ///< Parts filled in the current broadcast
+        std::vector<int32_t> sent[WINDOW]; ///< Per frame: IDs sent to the AOI clients this worker encoded (see ClientView)
+        std::vector<PendingEntry> pending[WINDOW];  ///< Per frame: players the budget deferred for those clients
+        size_t sentCapacity = 0;           ///< Largest `sent` so far; every frame reserves it
+        size_t pendingCapacity = 0;
+        BroadcastStats stats;              ///< Merged into SnapshotBroadcaster::stats after each broadcast
+    };
+
+    PartRange encodeFull(EncodeContext& ctx, const WorldSnapshot& snap, uint32_t seq, PlayerCodec codec,
+                         const uint32_t* indices, size_t count);
+    void collectDelta(EncodeContext& ctx, const WorldSnapshot& snap, const SnapshotPlayer& viewer, uint32_t seq,
+                      const uint32_t* indices, size_t count, const WorldFrame& base, const int32_t* base_ids, size_t base_count,
+                      const PendingEntry* base_pending, size_t pending_count);
+    void deferPlayer(EncodeContext& ctx, int32_t id, uint32_t since, bool held, uint32_t seq);
+    void carryWaits(EncodeContext& ctx, const ClientView& view, uint32_t seq);
+    bool isTierDue(const SnapshotPlayer& viewer, const SnapshotPlayer& p, uint32_t seq, uint32_t gap,
+                   uint32_t& held_since) const;
+    size_t applyBudget(EncodeContext& ctx, const WorldSnapshot& snap, const SnapshotPlayer& viewer,
+                       const WorldFrame* base, uint32_t seq, PlayerCodec codec);
+    PartRange encodeParts(EncodeContext& ctx, const WorldSnapshot& snap, uint32_t seq, uint32_t baseline,
+                          PlayerCodec codec, const uint32_t* indices, size_t count,
+                          const std::vector<int32_t>& removed_ids);
+    void encodeClient(EncodeContext& ctx, size_t i);
+    void beginPacket(EncodeContext& ctx, const WorldSnapshot& snap, uint32_t seq, uint32_t baseline, uint32_t part,
+                     uint32_t part_count);
+    void refreshFragments(const WorldSnapshot& snap);
+    void writeProtobufPart(std::string& out, const WorldSnapshot& snap, uint32_t seq, uint32_t baseline,
+                           uint32_t part, uint32_t part_count, const int32_t* removed_ids, size_t removed_count,
+                           const uint32_t* indices, size_t count) const;
+    static uint32_t nextStamp(EncodeContext& ctx);
+    void queueParts(Transport& transport, const sockaddr_in& addr, PartRange range);
+    uint64_t partsBytes(PartRange range) const;
+    uint64_t partsOverMtu(PartRange range) const;
+    void mergeStats(const BroadcastStats& from);
+
+    int interestRadius;
+    size_t clientBudget;
+    std::vector<UpdateTier> tiers;
+    InterestGrid grid;
+    BroadcastStats stats;
+
+    WorldFrame frames[WINDOW];         ///< Ring indexed by seq % WINDOW
+    std::vector<ClientView> views;     ///< Indexed by player ID slot
+    std::vector<PlayerFragment> fragments;  ///< Indexed by player ID slot
+
+    WorkerPool pool;
+    std::vector<std::unique_ptr<EncodeContext>> contexts;  ///< One per pool worker
+
+    // Current broadcast, read by the workers.
+    const WorldSnapshot* current = nullptr;
+    uint32_t currentSeq = 0;
+
+    // Reused between broadcasts.
+    std::vector<int32_t> xs;
+    std::vector<int32_t> ys;
+    std::vector<uint32_t> everyone;
+    std::vector<PartRange> clientParts;  ///< What each snapshot player is sent, by snapshot index
+    std::vector<uint32_t> tierPhase;   ///< Per slot and tier: snapshots since that tier was last due
+    PartRange fullState;               ///< Whole world, protobuf codec (also sent to the viewer)
+    PartRange fullPacked;              ///< Whole world, packed codec; encoded before the workers start
+    // Sizes of fullState / fullPacked, measured before the workers start:
+    // worker 0 appends to the context holding them while others are sending them.
+    uint64_t fullStateSize = 0;        ///< Bytes, also checked against the budget
+    uint64_t fullPackedSize = 0;
+    uint64_t fullStateOverMtu = 0;     ///< Parts above SNAPSHOT_MTU_PAYLOAD
+    uint64_t fullPackedOverMtu = 0;
+};
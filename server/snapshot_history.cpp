@@ -0,0 +1,112 @@
+#include "snapshot_history.h"
+#include "slot_map.h"
+#include <algorithm>
+#include <cstring>
+
+SnapshotHistory::SnapshotHistory(size_t capacity, size_t max_players)
+    : frames(std::max<size_t>(1, capacity)) {
+    for (Frame& f : frames) {
+        f.ids.reserve(max_players);
+        f.xs.reserve(max_players);
+        f.ys.reserve(max_players);
+        f.blocked.reserve(max_players);
+        f.rowOfSlot.resize(max_players, 0);
+    }
+}
+
+void SnapshotHistory::clear() {
+    for (Frame& f : frames) {
+        f.tick = -1;
+        f.ids.clear();
+    }
+    retained = 0;
+}
+
+void SnapshotHistory::record(int tick, const PlayerStore& players) {
+    if (retained > 0 && tick <= newest) clear();  // Tick counter restarted
+
+    // Ring positions of ticks skipped since the last record still hold an
+    // older tick; contains() rejects them by tick number.
+    const size_t cap = frames.size();
+    retained = retained == 0 ? 1 : std::min(cap, retained + static_cast<size_t>(tick - newest));
+    newest = tick;
+
+    Frame& f = frames[static_cast<size_t>(tick) % cap];
+    const size_t n = players.size();
+    f.tick = tick;
+    f.ids.resize(n);
+    f.xs.resize(n);
+    f.ys.resize(n);
+    f.blocked.resize(n);
+    if (n) {
+        std::memcpy(f.ids.data(), players.getIds().data(), n * sizeof(int32_t));
+        std::memcpy(f.xs.data(), players.getX().data(), n * sizeof(int32_t));
+        std::memcpy(f.ys.data(), players.getY().data(), n * sizeof(int32_t));
+        std::memcpy(f.blocked.data(), players.getBlocked().data(), n);
+    }
+    // Rows of departed players are left in the table; rowOf() rejects them
+    // by comparing the ID stored at that row.
+    for (size_t row = 0; row < n; ++row) {
+        uint32_t slot = slotIndexOf(f.ids[row]);
+        if (slot >= f.rowOfSlot.size()) f.rowOfSlot.resize(slot + 1, 0);
+        f.rowOfSlot[slot] = static_cast<uint32_t>(row);
+    }
+}
+
+bool SnapshotHistory::contains(int tick) const {
+    return retained > 0 && tick <= newest && tick > newest - static_cast<int>(retained) &&
+           frames[static_cast<size_t>(tick) % frames.size()].tick == tick;
+}
+
+const SnapshotHistory::Frame* SnapshotHistory::frameFor(int tick) const {
+    return contains(tick) ? &frames[static_cast<size_t>(tick) % frames.size()] : nullptr;
+}
+
+bool SnapshotHistory::rowOf(const Frame& f, int id, uint32_t& row) {
+    uint32_t slot = slotIndexOf(id);
+    if (slot >= f.rowOfSlot.size()) return false;
+    row = f.rowOfSlot[slot];
+    return row < f.ids.size() && f.ids[row] == id;
+}
+
+bool SnapshotHistory::at(int tick, HistoryTick& out) const {
+    const Frame* f = frameFor(tick);
+    if (!f) return false;
+    out.tick = tick;
+    out.count = f->ids.size();
+    out.ids = f->ids.data();
+    out.xs = f->xs.data();
+    out.ys = f->ys.data();
+    out.blocked = f->blocked.data();
+    return true;
+}
+
+bool SnapshotHistory::find(int tick, int id, int& x, int& y, bool& blocked) const {
+    const Frame* f = frameFor(tick);
+    uint32_t row;
+    if (!f || !rowOf(*f, id, row)) return false;
+    x = f->xs[row];
+    y = f->ys[row];
+    blocked = f->blocked[row] != 0;
+    return true;
+}
+
+bool SnapshotHistory::diff(int from, int to, std::vector<int32_t>& changed, std::vector<int32_t>& removed) const {
+    const Frame* a = frameFor(from);
+    const Frame* b = frameFor(to);
+    if (!a || !b) return false;
+    changed.clear();
+    removed.clear();
+    uint32_t row;
+    for (size_t i = 0; i < b->ids.size(); ++i) {
+        const int32_t id = b->ids[i];
+        if (!rowOf(*a, id, row) || a->xs[row] != b->xs[i] || a->ys[row] != b->ys[i] ||
+            a->blocked[row] != b->blocked[i]) {
+            changed.push_back(id);
+        }
+    }
+    for (size_t i = 0; i < a->ids.size(); ++i) {
+        if (!rowOf(*b, a->ids[i], row)) removed.push_back(a->ids[i]);
+    }
+    return true;
+}
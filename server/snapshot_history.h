@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "player_store.h"
+
+/**
+ * @brief Players as they were at the end of one retained tick (see SnapshotHistory::at()).
+ *
+ * Columns are parallel arrays of `count` rows, in PlayerStore row order of
+ * that tick. Valid until that tick is overwritten by a later record().
+ */
+struct HistoryTick {
+    int tick = 0;
+    size_t count = 0;
+    const int32_t* ids = nullptr;
+    const int32_t* xs = nullptr;
+    const int32_t* ys = nullptr;
+    const uint8_t* blocked = nullptr;
+};
+
+/**
+ * @brief Fixed-capacity ring of the last `capacity` ticks of player state,
+ * for lag compensation, replay and deltas between arbitrary ticks.
+ *
+ * Every tick is stored as structure-of-arrays columns (id, x, y, blocked)
+ * copied straight from the PlayerStore columns, plus a table mapping each
+ * ID slot to its row in that tick. All of it is allocated up front for
+ * `max_players`, so record() is a handful of memcpy()s and a linear pass,
+ * with no allocation unless the player count or ID slots exceed that.
+ *
+ * Ticks are addressed by number: tick T lives in ring position
+ * T % capacity, so at() and find() are O(1), and diff() between any two
+ * retained ticks is linear in their player counts with no scratch state.
+ * Tick numbers must increase between record() calls; a tick number that
+ * goes backwards (the counter restarts with each game) clears the ring.
+ *
+ * Owned by the simulation thread; not thread-safe.
+ */
+class SnapshotHistory {
+public:
+    /**
+     * @param capacity Ticks retained (>= 1).
+     * @param max_players Players (and ID slots) preallocated per tick.
+     */
+    SnapshotHistory(size_t capacity, size_t max_players);
+
+    /**
+     * @brief Stores the players' state at the end of `tick`, replacing the
+     * tick `capacity` ticks older.
+     */
+    void record(int tick, const PlayerStore& players);
+
+    /**
+     * @brief Forgets every retained tick (buffers keep their capacity).
+     */
+    void clear();
+
+    size_t capacity() const { return frames.size(); }
+
+    /**
+     * @brief Number of ticks currently retained.
+     */
+    size_t size() const { return retained; }
+
+    /**
+     * @brief Newest and oldest retained tick numbers (only meaningful if size() > 0).
+     */
+    int newestTick() const { return newest; }
+    int oldestTick() const { return newest - static_cast<int>(retained) + 1; }
+
+    /**
+     * @brief True if `tick` is still in the ring.
+     */
+    bool contains(int tick) const;
+
+    /**
+     * @brief Columns of a retained tick.
+     * @return false if `tick` is not retained.
+     */
+    bool at(int tick, HistoryTick& out) const;
+
+    /**
+     * @brief State of player `id` at `tick`.
+     * @return false if the tick is not retained or the player was not present.
+     */
+    bool find(int tick, int id, int& x, int& y, bool& blocked) const;
+
+    /**
+     * @brief Players that differ between two retained ticks.
+     *
+     * `changed` gets the IDs present at `to` that were absent at `from` or
+     * whose position or blocked flag differs; `removed` gets the IDs present
+     * at `from` but gone at `to`. Both are cleared first. Either order of
+     * ticks is allowed.
+     *
+     * @return false if either tick is not retained.
+     */
+    bool diff(int from, int to, std::vector<int32_t>& changed, std::vector<int32_t>& removed) const;
+
+private:
+    struct Frame {
+        int tick = -1;                    ///< -1 = empty
+        std::vector<int32_t> ids;
+        std::vector<int32_t> xs;
+        std::vector<int32_t> ys;
+        std::vector<uint8_t> blocked;
+        std::vector<uint32_t> rowOfSlot;  ///< ID slot -> row in this frame (check ids[row] against the ID)
+    };
+
+    const Frame* frameFor(int tick) const;
+    static bool rowOf(const Frame& f, int id, uint32_t& row);
+
+    std::vector<Frame> frames;  ///< Ring indexed by tick % capacity
+    size_t retained = 0;
+    int newest = 0;
+};
@@ -0,0 +1,113 @@
+#include "spatial_grid.h"
+#include "slot_map.h"
+#include "proximity_kernel.h"
+
+namespace {
+
+// Floor division so cells left of/below the origin do not merge with cell 0.
+int64_t cellOf(int v, int size) {
+    int64_t q = v / size;
+    return (v % size < 0) ? q - 1 : q;
+}
+
+}  // namespace
+
+SpatialGrid::SpatialGrid(int cell_size, size_t bucket_count)
+    : cellSize(cell_size) {
+    size_t n = 1;
+    while (n < bucket_count) n <<= 1;
+    buckets.resize(n);
+    mask = static_cast<uint32_t>(n - 1);
+}
+
+uint32_t SpatialGrid::bucketFor(int64_t cx, int64_t cy) const {
+    uint64_t h = (static_cast<uint64_t>(cx) * 0x9E3779B97F4A7C15ull) ^
+                 (static_cast<uint64_t>(cy) * 0xC2B2AE3D27D4EB4Full);
+    return static_cast<uint32_t>(h >> 32) & mask;
+}
+
+uint32_t SpatialGrid::bucketAt(int x, int y) const {
+    return bucketFor(cellOf(x, cellSize), cellOf(y, cellSize));
+}
+
+void SpatialGrid::append(uint32_t slot, uint32_t bucket, int id, int x, int y) {
+    Bucket& b = buckets[bucket];
+    locations[slot] = {bucket, static_cast<uint32_t>(b.ids.size()), true};
+    b.ids.push_back(id);
+    b.xs.push_back(x);
+    b.ys.push_back(y);
+}
+
+void SpatialGrid::detach(uint32_t slot) {
+    Location& loc = locations[slot];
+    Bucket& b = buckets[loc.bucket];
+    if (loc.index + 1 != b.ids.size()) {
+        b.ids[loc.index] = b.ids.back();
+        b.xs[loc.index] = b.xs.back();
+        b.ys[loc.index] = b.ys.back();
+        locations[slotIndexOf(b.ids[loc.index])].index = loc.index;
+    }
+    b.ids.pop_back();
+    b.xs.pop_back();
+    b.ys.pop_back();
+    loc.present = false;
+}
+
+void SpatialGrid::insert(int id, int x, int y) {
+    uint32_t slot = slotIndexOf(id);
+    if (slot >= locations.size()) locations.resize(slot + 1);
+    if (locations[slot].present) detach(slot);
+    append(slot, bucketAt(x, y), id, x, y);
+}
+
+void SpatialGrid::move(int id, int x, int y) {
+    uint32_t slot = slotIndexOf(id);
+    if (slot >= locations.size() || !locations[slot].present) {
+        insert(id, x, y);
+        return;
+    }
+    Location& loc = locations[slot];
+    uint32_t bucket = bucketAt(x, y);
+    if (bucket == loc.bucket) {
+        buckets[bucket].xs[loc.index] = x;
+        buckets[bucket].ys[loc.index] = y;
+        return;
+    }
+    detach(slot);
+    append(slot, bucket, id, x, y);
+}
+
+void SpatialGrid::remove(int id) {
+    uint32_t slot = slotIndexOf(id);
+    if (slot < locations.size() && locations[slot].present) detach(slot);
+}
+
+bool SpatialGrid::anyWithin(int x, int y, int radius, int exclude_id) const {
+    const int64_t cx = cellOf(x, cellSize);
+    const int64_t cy = cellOf(y, cellSize);
+
+    uint32_t visited[9];
+    int visited_count = 0;
+    for (int64_t dy = -1; dy <= 1; ++dy) {
+        for (int64_t dx = -1; dx <= 1; ++dx) {
+            uint32_t bucket = bucketFor(cx + dx, cy + dy);
+            bool seen = false;
+            for (int i = 0; i < visited_count; ++i) seen |= (visited[i] == bucket);
+            if (seen) continue;
+            visited[visited_count++] = bucket;
+
+            const Bucket& b = buckets[bucket];
+            for (size_t base = 0, n = b.ids.size(); base < n; base += PROXIMITY_BLOCK) {
+                size_t count = n - base < PROXIMITY_BLOCK ? n - base : PROXIMITY_BLOCK;
+                uint64_t hits = proximityMask(b.xs.data() + base, b.ys.data() + base, count, x, y, radius);
+                // Hits are rare; only then look at ids to skip the querying player.
+                while (hits) {
+                    int i = __builtin_ctzll(hits);
+                    if (b.ids[base + i] != exclude_id) return true;
+                    hits &= hits - 1;
+                }
+            }
+        }
+    }
+    return false;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "collision_engine.h"
+
+/**
+ * @brief Uniform spatial hash grid over player positions.
+ *
+ * The plane is cut into square cells of `cell_size`; each cell hashes to
+ * one of a fixed number of buckets, and a bucket stores {id, x, y} entries
+ * contiguously so a query scans plain memory. With a query radius no
+ * larger than the cell size, every neighbour lies in the 3x3 block of
+ * cells around the query point. Distinct cells may share a bucket; that
+ * only adds candidates, which the distance test filters out. Buckets keep
+ * ids, x and y in separate arrays so the SIMD proximity kernel can test a
+ * whole block of candidates per call.
+ *
+ * Entries are indexed by the slot part of the player ID (see SlotMap), so
+ * insert/move/remove are O(1): a move within the same bucket rewrites the
+ * entry in place, otherwise it is swap-removed from the old bucket and
+ * appended to the new one.
+ */
+class SpatialGrid : public CollisionEngine {
+public:
+    /**
+     * @param cell_size Cell edge length; query radii must not exceed it.
+     * @param bucket_count Number of hash buckets (rounded up to a power of two).
+     */
+    SpatialGrid(int cell_size, size_t bucket_count);
+
+    void insert(int id, int x, int y) override;
+    void move(int id, int x, int y) override;
+    void remove(int id) override;
+
+    /**
+     * @brief True if any entry other than `exclude_id` lies strictly closer than `radius` to (x, y).
+     *
+     * @param radius Must be <= cell size (and <= PROXIMITY_MAX_RADIUS).
+     */
+    bool anyWithin(int x, int y, int radius, int exclude_id) const override;
+
+    int getMaxRadius() const override { return cellSize; }
+    const char* name() const override { return "grid"; }
+
+private:
+    struct Bucket {
+        std::vector<int32_t> ids;
+        std::vector<int32_t> xs;
+        std::vector<int32_t> ys;
+    };
+
+    struct Location {
+        uint32_t bucket = 0;
+        uint32_t index = 0;  ///< Position inside the bucket's entry vector
+        bool present = false;
+    };
+
+    uint32_t bucketFor(int64_t cx, int64_t cy) const;
+    uint32_t bucketAt(int x, int y) const;
+    void append(uint32_t slot, uint32_t bucket, int id, int x, int y);
+    void detach(uint32_t slot);
+
+    int cellSize;
+    uint32_t mask;
+    std::vector<Bucket> buckets;
+    std::vector<Location> locations;  ///< Indexed by ID slot
+};
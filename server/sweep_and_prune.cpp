@@ -0,0 +1,86 @@
+#include "sweep_and_prune.h"
+#include "proximity_kernel.h"
+#include "slot_map.h"
+#include <algorithm>
+
+uint32_t& SweepAndPrune::indexSlot(int id) {
+    uint32_t slot = slotIndexOf(id);
+    if (slot >= indexOf.size()) indexOf.resize(slot + 1, ABSENT);
+    return indexOf[slot];
+}
+
+void SweepAndPrune::place(size_t i, int id, int x, int y) {
+    ids[i] = id;
+    xs[i] = x;
+    ys[i] = y;
+    indexOf[slotIndexOf(id)] = static_cast<uint32_t>(i);
+}
+
+void SweepAndPrune::reindexFrom(size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        indexOf[slotIndexOf(ids[i])] = static_cast<uint32_t>(i);
+    }
+}
+
+void SweepAndPrune::insert(int id, int x, int y) {
+    if (indexSlot(id) != ABSENT) remove(id);
+
+    size_t pos = std::upper_bound(xs.begin(), xs.end(), x) - xs.begin();
+    xs.insert(xs.begin() + pos, x);
+    ys.insert(ys.begin() + pos, y);
+    ids.insert(ids.begin() + pos, id);
+    reindexFrom(pos, ids.size());
+}
+
+void SweepAndPrune::move(int id, int x, int y) {
+    uint32_t index = indexSlot(id);
+    if (index == ABSENT) {
+        insert(id, x, y);
+        return;
+    }
+
+    // Insertion-sort step: slide the player to its new place in x order.
+    size_t i = index;
+    while (i > 0 && xs[i - 1] > x) {
+        place(i, ids[i - 1], xs[i - 1], ys[i - 1]);
+        --i;
+    }
+    while (i + 1 < xs.size() && xs[i + 1] < x) {
+        place(i, ids[i + 1], xs[i + 1], ys[i + 1]);
+        ++i;
+    }
+    place(i, id, x, y);
+}
+
+void SweepAndPrune::remove(int id) {
+    uint32_t slot = slotIndexOf(id);
+    if (slot >= indexOf.size() || indexOf[slot] == ABSENT) return;
+
+    size_t pos = indexOf[slot];
+    xs.erase(xs.begin() + pos);
+    ys.erase(ys.begin() + pos);
+    ids.erase(ids.begin() + pos);
+    indexOf[slot] = ABSENT;
+    reindexFrom(pos, ids.size());
+}
+
+bool SweepAndPrune::anyWithin(int x, int y, int radius, int exclude_id) const {
+    // Candidates satisfy x - radius < xs[i] < x + radius.
+    size_t lo = std::upper_bound(xs.begin(), xs.end(), x - radius) - xs.begin();
+    size_t hi = std::lower_bound(xs.begin() + lo, xs.end(), x + radius) - xs.begin();
+
+    for (size_t base = lo; base < hi; base += PROXIMITY_BLOCK) {
+        size_t count = hi - base < PROXIMITY_BLOCK ? hi - base : PROXIMITY_BLOCK;
+        uint64_t hits = proximityMask(xs.data() + base, ys.data() + base, count, x, y, radius);
+        while (hits) {
+            int i = __builtin_ctzll(hits);
+            if (ids[base + i] != exclude_id) return true;
+            hits &= hits - 1;
+        }
+    }
+    return false;
+}
+
+int SweepAndPrune::getMaxRadius() const {
+    return PROXIMITY_MAX_RADIUS;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "collision_engine.h"
+
+/**
+ * @brief Sort-based broadphase: players kept sorted by x coordinate.
+ *
+ * A query binary-searches the slab of players whose x lies within the
+ * radius and tests only those with the SIMD proximity kernel. Unlike a
+ * uniform grid it has no cell size to tune, so dense clusters cost the
+ * width of the slab rather than the population of whole cells.
+ *
+ * Positions live in x-sorted SoA arrays. Movement between ticks is small,
+ * so move() restores order with an insertion-sort step that shifts the
+ * player past the few neighbours it overtook; insert() and remove() shift
+ * the arrays and are O(N), which is fine for joins and leaves.
+ */
+class SweepAndPrune : public CollisionEngine {
+public:
+    void insert(int id, int x, int y) override;
+    void move(int id, int x, int y) override;
+    void remove(int id) override;
+    bool anyWithin(int x, int y, int radius, int exclude_id) const override;
+    int getMaxRadius() const override;
+    const char* name() const override { return "sap"; }
+
+    size_t size() const { return ids.size(); }
+
+private:
+    static constexpr uint32_t ABSENT = UINT32_MAX;
+
+    uint32_t& indexSlot(int id);
+    void place(size_t i, int id, int x, int y);
+    void reindexFrom(size_t begin, size_t end);
+
+    // Sorted by xs.
+    std::vector<int32_t> xs;
+    std::vector<int32_t> ys;
+    std::vector<int32_t> ids;
+    std::vector<uint32_t> indexOf;  ///< ID slot -> position in the sorted arrays
+};
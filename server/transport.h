@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <netinet/in.h>
+
+/**
+ * @brief Outgoing datagram path used by the game logic.
+ *
+ * GameManager and ClientManager send through this interface instead of a
+ * raw socket, so the simulation can run against real UDP (UdpTransport,
+ * BatchedUdpTransport) or entirely in process (InMemoryTransport) for
+ * benchmarks and tests.
+ *
+ * Datagrams are either sent immediately (sendTo) or queued and handed over
+ * in one go by flush(); queued payloads must stay valid until flush()
+ * returns. The UDP transports allow sendTo() from the simulation thread
+ * while the broadcast thread queues and flushes; everything else is
+ * single-threaded.
+ */
+class Transport {
+public:
+    virtual ~Transport() = default;
+
+    /**
+     * @brief Sends one datagram right away (e.g. a handshake reply).
+     */
+    virtual void sendTo(const sockaddr_in& addr, const void* data, size_t len) = 0;
+
+    /**
+     * @brief Queues one datagram for the next flush().
+     */
+    virtual void queue(const sockaddr_in& addr, const void* data, size_t len) = 0;
+
+    /**
+     * @brief Queues a run of `segment_size`-byte datagrams (the last may be shorter).
+     *
+     * Transports that support segmentation offload send the run as one
+     * message; the default splits it into individual datagrams.
+     */
+    virtual void queueSegmented(const sockaddr_in& addr, const void* data, size_t len, size_t segment_size) {
+        const char* bytes = static_cast<const char*>(data);
+        size_t step = segment_size ? segment_size : len;
+        for (size_t off = 0; off < len; off += step) {
+            queue(addr, bytes + off, len - off < step ? len - off : step);
+        }
+    }
+
+    /**
+     * @brief Sends everything queued since the last flush.
+     * @return Number of datagrams delivered.
+     */
+    virtual size_t flush() = 0;
+
+    /**
+     * @brief Marks the start of a broadcast tick (per-tick counters restart).
+     */
+    virtual void beginTick() {}
+
+    /**
+     * @brief Prints accumulated send counters and resets them.
+     */
+    virtual void logAndResetStats() {}
+
+    /**
+     * @brief Short name for logs ("plain", "batch", "gso", "uring", "memory").
+     */
+    virtual const char* name() const = 0;
+};
@@ -0,0 +1,92 @@
+#include "udp_transport.h"
+#include <iostream>
+#include <cerrno>
+#include <sys/socket.h>
+
+// --- UdpTransport ------------------------------------------------------------
+
+void UdpTransport::sendTo(const sockaddr_in& addr, const void* data, size_t len) {
+    sendto(sockfd, data, len, 0, (const sockaddr*)&addr, sizeof(addr));
+}
+
+void UdpTransport::queue(const sockaddr_in& addr, const void* data, size_t len) {
+    ssize_t n;
+    do {
+        n = sendto(sockfd, data, len, 0, (const sockaddr*)&addr, sizeof(addr));
+        tickStats.syscalls++;
+    } while (n < 0 && errno == EINTR);
+
+    if (n < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) tickStats.eagain++;
+        tickStats.dropped++;
+        return;
+    }
+    tickStats.datagrams++;
+    tickStats.bytes += len;
+    queuedSinceFlush++;
+}
+
+size_t UdpTransport::flush() {
+    size_t sent = queuedSinceFlush;
+    queuedSinceFlush = 0;
+    return sent;
+}
+
+void UdpTransport::beginTick() {
+    totalStats.add(tickStats);
+    tickStats = SendStats{};
+}
+
+void UdpTransport::logAndResetStats() {
+    if (totalStats.syscalls == 0 && tickStats.syscalls == 0) return;
+
+    std::cout << "[STATS] send (plain) tick: sent=" << tickStats.datagrams
+              << " syscalls=" << tickStats.syscalls
+              << " bytes=" << tickStats.bytes
+              << " | total: sent=" << totalStats.datagrams
+              << " syscalls=" << totalStats.syscalls
+              << " eagain=" << totalStats.eagain
+              << " dropped=" << totalStats.dropped << std::endl;
+
+    totalStats = SendStats{};
+}
+
+// --- BatchedUdpTransport -----------------------------------------------------
+
+BatchedUdpTransport::BatchedUdpTransport(int sockfd, SendMode mode, size_t expected_destinations)
+    : sockfd(sockfd),
+      sender(expected_destinations) {
+    sender.setMode(mode == SendMode::Plain ? SendMode::Batched : mode, sockfd);
+}
+
+void BatchedUdpTransport::sendTo(const sockaddr_in& addr, const void* data, size_t len) {
+    sendto(sockfd, data, len, 0, (const sockaddr*)&addr, sizeof(addr));
+}
+
+void BatchedUdpTransport::queue(const sockaddr_in& addr, const void* data, size_t len) {
+    sender.queue(addr, data, len);
+}
+
+void BatchedUdpTransport::queueSegmented(const sockaddr_in& addr, const void* data, size_t len,
+                                         size_t segment_size) {
+    sender.queueSegmented(addr, data, len, segment_size);
+}
+
+size_t BatchedUdpTransport::flush() {
+    return sender.flush(sockfd);
+}
+
+void BatchedUdpTransport::beginTick() {
+    sender.beginTick();
+}
+
+void BatchedUdpTransport::logAndResetStats() {
+    sender.logAndResetStats();
+}
+
+std::unique_ptr<Transport> makeUdpTransport(int sockfd, SendMode mode, size_t expected_destinations) {
+    if (mode == SendMode::Plain) {
+        return std::make_unique<UdpTransport>(sockfd);
+    }
+    return std::make_unique<BatchedUdpTransport>(sockfd, mode, expected_destinations);
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <memory>
+#include "transport.h"
+#include "batch_sender.h"
+
+/**
+ * @brief UDP transport with one sendto() per datagram.
+ *
+ * Queued datagrams are sent as they are queued; flush() only reports the
+ * count. This is the reference path the batched transports are measured
+ * against.
+ */
+class UdpTransport : public Transport {
+public:
+    /**
+     * @param sockfd UDP socket to send with; the caller keeps ownership.
+     */
+    explicit UdpTransport(int sockfd) : sockfd(sockfd) {}
+
+    void sendTo(const sockaddr_in& addr, const void* data, size_t len) override;
+    void queue(const sockaddr_in& addr, const void* data, size_t len) override;
+    size_t flush() override;
+    void beginTick() override;
+    void logAndResetStats() override;
+    const char* name() const override { return "plain"; }
+
+private:
+    int sockfd;
+    size_t queuedSinceFlush = 0;
+    SendStats tickStats;
+    SendStats totalStats;
+};
+
+/**
+ * @brief UDP transport that batches queued datagrams through a BatchSender.
+ *
+ * Supports SendMode::Batched (sendmmsg), SendMode::Gso (UDP_SEGMENT) and
+ * SendMode::Uring (io_uring); unsupported modes fall back to batched.
+ */
+class BatchedUdpTransport : public Transport {
+public:
+    /**
+     * @param sockfd UDP socket to send with; the caller keeps ownership.
+     * @param mode Requested send mode.
+     * @param expected_destinations Queue capacity to preallocate.
+     */
+    BatchedUdpTransport(int sockfd, SendMode mode, size_t expected_destinations);
+
+    void sendTo(const sockaddr_in& addr, const void* data, size_t len) override;
+    void queue(const sockaddr_in& addr, const void* data, size_t len) override;
+    void queueSegmented(const sockaddr_in& addr, const void* data, size_t len, size_t segment_size) override;
+    size_t flush() override;
+    void beginTick() override;
+    void logAndResetStats() override;
+    const char* name() const override { return sendModeName(sender.getMode()); }
+
+private:
+    int sockfd;
+    BatchSender sender;
+};
+
+/**
+ * @brief Creates the UDP transport for a send mode (plain → UdpTransport, others batched).
+ */
+std::unique_ptr<Transport> makeUdpTransport(int sockfd, SendMode mode, size_t expected_destinations);
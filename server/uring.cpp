@@ -0,0 +1,270 @@
+#include "uring.h"
+#include <algorithm>
+#include <iostream>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+constexpr uint16_t RECV_BUFFER_GROUP = 0;   ///< Buffer group ID of the receive ring
+constexpr uint64_t RECV_USER_DATA = 1;      ///< Tag of the multishot receive request
+
+static int sysSetup(unsigned entries, io_uring_params* p) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, p));
+}
+
+static int sysEnter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+static int sysRegister(int fd, unsigned opcode, const void* arg, unsigned nr_args) {
+    return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+// --- UringRing ---------------------------------------------------------------
+
+UringRing::~UringRing() {
+    if (sqes) munmap(sqes, sqesSize);
+    if (cqRing && cqRing != sqRing) munmap(cqRing, cqRingSize);
+    if (sqRing) munmap(sqRing, sqRingSize);
+    if (ringFd >= 0) close(ringFd);
+}
+
+bool UringRing::init(unsigned sq_entries, unsigned cq_entries) {
+    io_uring_params p;
+    std::memset(&p, 0, sizeof(p));
+    if (cq_entries > 0) {
+        p.flags |= IORING_SETUP_CQSIZE;
+        p.cq_entries = cq_entries;
+    }
+
+    ringFd = sysSetup(sq_entries, &p);
+    if (ringFd < 0) {
+        perror("io_uring_setup failed");
+        return false;
+    }
+
+    sqRingSize = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    cqRingSize = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+    bool single_mmap = p.features & IORING_FEAT_SINGLE_MMAP;
+    if (single_mmap) {
+        sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+    }
+
+    sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                  ringFd, IORING_OFF_SQ_RING);
+    if (sqRing == MAP_FAILED) {
+        sqRing = nullptr;
+        perror("io_uring mmap failed");
+        return false;
+    }
+    if (single_mmap) {
+        cqRing = sqRing;
+    } else {
+        cqRing = mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ringFd, IORING_OFF_CQ_RING);
+        if (cqRing == MAP_FAILED) {
+            cqRing = nullptr;
+            perror("io_uring mmap failed");
+            return false;
+        }
+    }
+
+    sqesSize = p.sq_entries * sizeof(io_uring_sqe);
+    void* sqe_mem = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         ringFd, IORING_OFF_SQES);
+    if (sqe_mem == MAP_FAILED) {
+        perror("io_uring mmap failed");
+        return false;
+    }
+    sqes = static_cast<io_uring_sqe*>(sqe_mem);
+
+    char* sq = static_cast<char*>(sqRing);
+    char* cq = static_cast<char*>(cqRing);
+    sqHead = reinterpret_cast<unsigned*>(sq + p.sq_off.head);
+    sqTail = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+    sqArray = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+    sqMask = *reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+    cqHead = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+    cqTail = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+    cqMask = *reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+    cqes = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+    sqEntries = p.sq_entries;
+
+    // SQ slots map 1:1 onto SQE indices.
+    for (unsigned i = 0; i < sqEntries; ++i) {
+        sqArray[i] = i;
+    }
+    sqeTail = sqeSubmitted = *sqTail;
+    return true;
+}
+
+bool UringRing::registerFile(int fd) {
+    if (sysRegister(ringFd, IORING_REGISTER_FILES, &fd, 1) < 0) {
+        perror("io_uring register files failed");
+        return false;
+    }
+    return true;
+}
+
+bool UringRing::registerBufferRing(io_uring_buf_ring* ring, unsigned entries, uint16_t bgid) {
+    io_uring_buf_reg reg;
+    std::memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = reinterpret_cast<uint64_t>(ring);
+    reg.ring_entries = entries;
+    reg.bgid = bgid;
+    if (sysRegister(ringFd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+        perror("io_uring register buffer ring failed");
+        return false;
+    }
+    return true;
+}
+
+io_uring_sqe* UringRing::getSqe() {
+    unsigned head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+    if (sqeTail - head >= sqEntries) return nullptr;
+    io_uring_sqe* sqe = &sqes[sqeTail & sqMask];
+    sqeTail++;
+    std::memset(sqe, 0, sizeof(*sqe));
+    return sqe;
+}
+
+int UringRing::submit(unsigned wait_for) {
+    unsigned to_submit = sqeTail - sqeSubmitted;
+    __atomic_store_n(sqTail, sqeTail, __ATOMIC_RELEASE);
+    sqeSubmitted = sqeTail;
+    if (to_submit == 0 && wait_for == 0) return 0;
+
+    int ret;
+    do {
+        ret = sysEnter(ringFd, to_submit, wait_for, wait_for ? IORING_ENTER_GETEVENTS : 0);
+        enterCalls++;
+    } while (ret < 0 && errno == EINTR);
+    return ret < 0 ? -errno : ret;
+}
+
+// --- UringReceiver -----------------------------------------------------------
+
+UringReceiver::UringReceiver(unsigned buffer_count, size_t slot_size)
+    : bufferCount(buffer_count),
+      slotSize(slot_size),
+      bufferSize(sizeof(io_uring_recvmsg_out) + sizeof(sockaddr_in) + slot_size),
+      pool(static_cast<size_t>(buffer_count) * bufferSize) {
+    recvTemplate.msg_namelen = sizeof(sockaddr_in);
+    recvTemplate.msg_controllen = 0;
+}
+
+UringReceiver::~UringReceiver() {
+    if (bufRing) munmap(bufRing, bufRingBytes);
+}
+
+bool UringReceiver::init(int sockfd) {
+    if ((bufferCount & (bufferCount - 1)) != 0) {
+        std::cerr << "[ERROR] io_uring buffer count must be a power of two" << std::endl;
+        return false;
+    }
+    if (!ring.init(64, bufferCount * 2)) return false;
+    if (!ring.registerFile(sockfd)) return false;
+
+    bufRingBytes = bufferCount * sizeof(io_uring_buf);
+    void* mem = mmap(nullptr, bufRingBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) {
+        perror("mmap buffer ring failed");
+        return false;
+    }
+    bufRing = static_cast<io_uring_buf_ring*>(mem);
+    bufRing->tail = 0;
+    if (!ring.registerBufferRing(bufRing, bufferCount, RECV_BUFFER_GROUP)) return false;
+
+    for (unsigned i = 0; i < bufferCount; ++i) {
+        recycle(static_cast<uint16_t>(i));
+    }
+    return armReceive();
+}
+
+void UringReceiver::recycle(uint16_t bid) {
+    unsigned mask = bufferCount - 1;
+    uint16_t tail = bufRing->tail;
+    // Index entries from the ring base: in C++ the header's flexible `bufs`
+    // member is shifted past an empty struct and does not alias entry 0.
+    io_uring_buf& buf = reinterpret_cast<io_uring_buf*>(bufRing)[tail & mask];
+    buf.addr = reinterpret_cast<uint64_t>(pool.data() + static_cast<size_t>(bid) * bufferSize);
+    buf.len = static_cast<uint32_t>(bufferSize);
+    buf.bid = bid;
+    __atomic_store_n(&bufRing->tail, static_cast<uint16_t>(tail + 1), __ATOMIC_RELEASE);
+}
+
+bool UringReceiver::armReceive() {
+    io_uring_sqe* sqe = ring.getSqe();
+    if (!sqe) return false;
+    sqe->opcode = IORING_OP_RECVMSG;
+    sqe->fd = 0;                                   // fixed file index
+    sqe->flags = IOSQE_FIXED_FILE | IOSQE_BUFFER_SELECT;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->addr = reinterpret_cast<uint64_t>(&recvTemplate);
+    sqe->len = 1;
+    sqe->msg_flags = MSG_TRUNC;
+    sqe->buf_group = RECV_BUFFER_GROUP;
+    sqe->user_data = RECV_USER_DATA;
+
+    int ret = ring.submit();
+    if (ret < 0) {
+        std::cerr << "[ERROR] io_uring multishot recvmsg submit failed: " << strerror(-ret) << std::endl;
+        return false;
+    }
+    armed = true;
+    return true;
+}
+
+int UringReceiver::drain(const ReceiveStage::Handler& handler) {
+    int handled = 0;
+    int completions = 0;
+
+    ring.forEachCqe([&](const io_uring_cqe& cqe) {
+        if (cqe.user_data != RECV_USER_DATA) return;
+        if (!(cqe.flags & IORING_CQE_F_MORE)) armed = false;
+
+        if (cqe.res < 0) {
+            if (cqe.res != -ENOBUFS) {
+                std::cerr << "[WARN] io_uring recvmsg failed: " << strerror(-cqe.res) << std::endl;
+            }
+            return;
+        }
+        if (!(cqe.flags & IORING_CQE_F_BUFFER)) return;
+
+        uint16_t bid = static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+        const char* buf = pool.data() + static_cast<size_t>(bid) * bufferSize;
+        auto* out = reinterpret_cast<const io_uring_recvmsg_out*>(buf);
+        completions++;
+
+        if (out->flags & MSG_TRUNC) {
+            stats.truncated++;
+        } else if (out->namelen >= sizeof(sockaddr_in)) {
+            sockaddr_in from;
+            std::memcpy(&from, buf + sizeof(io_uring_recvmsg_out), sizeof(from));
+            const char* payload = buf + sizeof(io_uring_recvmsg_out) + recvTemplate.msg_namelen +
+                                  recvTemplate.msg_controllen;
+            handler(payload, out->payloadlen, from);
+            handled++;
+        }
+        recycle(bid);
+    });
+
+    if (completions > 0) {
+        stats.record(completions, static_cast<int>(bufferCount));
+    }
+    // The kernel ends a multishot request on errors or when buffers run out.
+    if (!armed) {
+        armReceive();
+    }
+    return handled;
+}
+
+void UringReceiver::logAndResetStats() {
+    if (stats.calls == 0) return;
+    stats.log("io_uring recv bufs=" + std::to_string(bufferCount));
+    stats = ReceiveStats{};
+}
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <linux/io_uring.h>
+#include "receive_stage.h"
+
+/**
+ * @brief Thin wrapper over a raw io_uring instance (no liburing dependency).
+ *
+ * Sets up and maps the submission/completion rings and exposes just what
+ * the server needs: grabbing SQEs, submitting, waiting, walking CQEs,
+ * registering the socket as a fixed file and registering a provided
+ * buffer ring. Not thread-safe; each ring belongs to one thread.
+ */
+class UringRing {
+public:
+    UringRing() = default;
+    ~UringRing();
+
+    UringRing(const UringRing&) = delete;
+    UringRing& operator=(const UringRing&) = delete;
+
+    /**
+     * @brief Creates the ring.
+     *
+     * @param sq_entries Submission queue size (rounded up to a power of two by the kernel).
+     * @param cq_entries Completion queue size (0 = kernel default of 2 * sq_entries).
+     * @return false if io_uring is unavailable or setup failed.
+     */
+    bool init(unsigned sq_entries, unsigned cq_entries = 0);
+
+    bool isReady() const { return ringFd >= 0; }
+
+    /**
+     * @brief The ring descriptor; pollable for completions.
+     */
+    int getFd() const { return ringFd; }
+
+    unsigned getSqEntries() const { return sqEntries; }
+
+    /**
+     * @brief Registers `fd` as fixed file index 0 (used with IOSQE_FIXED_FILE).
+     */
+    bool registerFile(int fd);
+
+    /**
+     * @brief Registers a provided-buffer ring for buffer group `bgid`.
+     */
+    bool registerBufferRing(io_uring_buf_ring* ring, unsigned entries, uint16_t bgid);
+
+    /**
+     * @brief Returns a zeroed SQE, or nullptr if the submission queue is full.
+     */
+    io_uring_sqe* getSqe();
+
+    /**
+     * @brief Submits pending SQEs and optionally waits for completions.
+     *
+     * @param wait_for Minimum completions to wait for (0 = don't wait).
+     * @return Number of SQEs consumed, or -errno.
+     */
+    int submit(unsigned wait_for = 0);
+
+    /**
+     * @brief Calls `fn(const io_uring_cqe&)` for every available CQE and consumes them.
+     *
+     * @return Number of CQEs processed.
+     */
+    template <typename Fn>
+    unsigned forEachCqe(Fn&& fn) {
+        unsigned head = *cqHead;
+        unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+        unsigned n = 0;
+        while (head != tail) {
+            fn(cqes[head & cqMask]);
+            head++;
+            n++;
+        }
+        __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+        return n;
+    }
+
+    /**
+     * @brief io_uring_enter() calls issued so far.
+     */
+    uint64_t getEnterCalls() const { return enterCalls; }
+
+private:
+    int ringFd = -1;
+    unsigned sqEntries = 0;
+    unsigned sqMask = 0;
+    unsigned cqMask = 0;
+    unsigned sqeTail = 0;        ///< Next SQE slot to hand out
+    unsigned sqeSubmitted = 0;   ///< SQEs already published to the kernel
+
+    void* sqRing = nullptr;
+    void* cqRing = nullptr;
+    size_t sqRingSize = 0;
+    size_t cqRingSize = 0;
+    io_uring_sqe* sqes = nullptr;
+    size_t sqesSize = 0;
+
+    unsigned* sqHead = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned* sqArray = nullptr;
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    io_uring_cqe* cqes = nullptr;
+
+    uint64_t enterCalls = 0;
+};
+
+/**
+ * @brief io_uring receive path: multishot RECVMSG over a provided-buffer ring.
+ *
+ * A single multishot RECVMSG request keeps producing one completion per
+ * datagram without being re-submitted. The kernel picks receive buffers
+ * from a registered ring of `buffer_count` slots, and the socket is a
+ * registered (fixed) file, so steady-state receiving costs no syscalls
+ * beyond the epoll wakeup. Datagrams are dispatched with the same handler
+ * signature as ReceiveStage.
+ */
+class UringReceiver {
+public:
+    /**
+     * @param buffer_count Number of provided receive buffers (power of two).
+     * @param slot_size Payload bytes per buffer.
+     */
+    UringReceiver(unsigned buffer_count, size_t slot_size);
+    ~UringReceiver();
+
+    /**
+     * @brief Creates the ring, registers `sockfd` and buffers, arms the multishot receive.
+     * @return false if io_uring or a required feature is unavailable.
+     */
+    bool init(int sockfd);
+
+    /**
+     * @brief Descriptor to watch for readiness (the ring fd).
+     */
+    int getFd() const { return ring.getFd(); }
+
+    /**
+     * @brief Dispatches every completed datagram to `handler` and recycles its buffer.
+     * @return Number of datagrams handled.
+     */
+    int drain(const ReceiveStage::Handler& handler);
+
+    const ReceiveStats& getStats() const { return stats; }
+
+    /**
+     * @brief Prints a one-line summary of the statistics and resets them.
+     */
+    void logAndResetStats();
+
+private:
+    bool armReceive();
+    void recycle(uint16_t bid);
+
+    UringRing ring;
+    unsigned bufferCount;
+    size_t slotSize;
+    size_t bufferSize;                 ///< Header + address + payload per buffer
+    std::vector<char> pool;            ///< bufferCount * bufferSize receive memory
+    io_uring_buf_ring* bufRing = nullptr;
+    size_t bufRingBytes = 0;
+    msghdr recvTemplate{};             ///< Tells the kernel how much room to reserve for the address
+    bool armed = false;
+    ReceiveStats stats;
+};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <netinet/in.h>  // for sockaddr_in
 #include <arpa/inet.h>   // for inet_ntop
@@ -18,4 +19,20 @@ inline std::string formatSockAddr(const sockaddr_in& addr) {
     inet_ntop(AF_INET, &(addr.sin_addr), ip, INET_ADDRSTRLEN);
     int port = ntohs(addr.sin_port);
     return std::string(ip) + ":" + std::to_string(port);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Packed IPv4 address and port identifying one client endpoint.
+ *
+ * Layout: address in bits 16..47, port in bits 0..15 (both host order).
+ * Building it is two byte swaps, so it is used for lookups on the receive
+ * path; formatSockAddr() is only for log lines.
+ */
+using EndpointKey = uint64_t;
+
+/**
+ * @brief Packs a sockaddr_in into an EndpointKey.
+ */
+inline EndpointKey makeEndpointKey(const sockaddr_in& addr) {
+    return (static_cast<uint64_t>(ntohl(addr.sin_addr.s_addr)) << 16) | ntohs(addr.sin_port);
+}
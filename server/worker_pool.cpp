@@ -0,0 +1,126 @@
+#include "worker_pool.h"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+uint64_t pack(size_t begin, size_t end) {
+    return (static_cast<uint64_t>(begin) << 32) | static_cast<uint32_t>(end);
+}
+
+}  // namespace
+
+WorkerPool::WorkerPool(unsigned workers) {
+    workers = std::max(1u, workers);
+    for (unsigned w = 0; w < workers; ++w) slices.push_back(std::make_unique<Slice>());
+    for (unsigned w = 1; w < workers; ++w) threads.emplace_back([this, w]() { threadMain(w); });
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeup.notify_all();
+    for (std::thread& t : threads) t.join();
+}
+
+void WorkerPool::resetCounters() {
+    for (auto& s : slices) {
+        s->busyNs = 0;
+        s->steals = 0;
+    }
+}
+
+bool WorkerPool::takeFront(Slice& s, size_t& begin, size_t& end) {
+    uint64_t cur = s.bounds.load(std::memory_order_acquire);
+    while (true) {
+        size_t b = cur >> 32, e = static_cast<uint32_t>(cur);
+        if (b >= e) return false;
+        size_t next = std::min(e, b + grain);
+        if (s.bounds.compare_exchange_weak(cur, pack(next, e), std::memory_order_acq_rel)) {
+            begin = b;
+            end = next;
+            return true;
+        }
+    }
+}
+
+bool WorkerPool::stealBack(Slice& s, size_t& begin, size_t& end) {
+    uint64_t cur = s.bounds.load(std::memory_order_acquire);
+    while (true) {
+        size_t b = cur >> 32, e = static_cast<uint32_t>(cur);
+        if (b >= e) return false;
+        size_t mid = b + (e - b) / 2;  // Leave the owner the front half (it may be mid-chunk there)
+        if (s.bounds.compare_exchange_weak(cur, pack(b, mid), std::memory_order_acq_rel)) {
+            begin = mid;
+            end = e;
+            return true;
+        }
+    }
+}
+
+void WorkerPool::work(unsigned w) {
+    auto t0 = std::chrono::steady_clock::now();
+    Slice& own = *slices[w];
+    const unsigned n = size();
+    size_t begin, end;
+    while (true) {
+        while (takeFront(own, begin, end)) (*task)(w, begin, end);
+
+        // Own slice is drained: steal half of someone else's and keep going.
+        bool stole = false;
+        for (unsigned k = 1; k < n && !stole; ++k) {
+            if (stealBack(*slices[(w + k) % n], begin, end)) {
+                own.bounds.store(pack(begin, end), std::memory_order_release);
+                own.steals++;
+                stole = true;
+            }
+        }
+        if (!stole) break;
+    }
+    own.busyNs += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::steady_clock::now() - t0).count();
+}
+
+void WorkerPool::run(size_t count, size_t chunk, const Task& fn) {
+    const unsigned n = size();
+    grain = std::max<size_t>(1, chunk);
+    task = &fn;
+    for (unsigned w = 0; w < n; ++w) {
+        slices[w]->bounds.store(pack(count * w / n, count * (w + 1) / n), std::memory_order_relaxed);
+    }
+    if (n > 1) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            generation++;
+            running = n - 1;
+        }
+        wakeup.notify_all();
+    }
+
+    work(0);
+
+    if (n > 1) {
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [this]() { return running == 0; });
+    }
+    task = nullptr;
+}
+
+void WorkerPool::threadMain(unsigned w) {
+    uint64_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeup.wait(lock, [&]() { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+        work(w);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--running == 0) finished.notify_one();
+        }
+    }
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Fixed pool of threads that split an index range with work stealing.
+ *
+ * run() hands every worker a contiguous slice of [0, count). A worker takes
+ * `grain`-sized chunks from the front of its own slice; once that is empty
+ * it steals the back half of another worker's remaining slice, so slices
+ * whose items turn out to be expensive (large interest sets) are shared
+ * instead of leaving cores idle. Each slice is one atomic begin/end pair,
+ * so taking and stealing are a single compare-and-swap.
+ *
+ * The calling thread is worker 0; a pool of one worker runs everything
+ * inline without touching the threads. run() must not be called
+ * concurrently.
+ */
+class WorkerPool {
+public:
+    /**
+     * @brief Processes items [begin, end) on the given worker.
+     */
+    using Task = std::function<void(unsigned worker, size_t begin, size_t end)>;
+
+    /**
+     * @param workers Total workers including the caller (>= 1).
+     */
+    explicit WorkerPool(unsigned workers);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    unsigned size() const { return static_cast<unsigned>(slices.size()); }
+
+    /**
+     * @brief Runs `task` over [0, count) on every worker and waits for all of them.
+     */
+    void run(size_t count, size_t grain, const Task& task);
+
+    /**
+     * @brief Nanoseconds worker `w` spent in run() (including stealing) since the last reset.
+     */
+    uint64_t getBusyNs(unsigned w) const { return slices[w]->busyNs; }
+
+    /**
+     * @brief Chunks worker `w` stole from other workers since the last reset.
+     */
+    uint64_t getSteals(unsigned w) const { return slices[w]->steals; }
+
+    void resetCounters();
+
+private:
+    struct alignas(64) Slice {
+        std::atomic<uint64_t> bounds{0};  ///< begin << 32 | end
+        uint64_t busyNs = 0;              ///< Written by the owning worker only
+        uint64_t steals = 0;
+    };
+
+    void work(unsigned w);
+    bool takeFront(Slice& s, size_t& begin, size_t& end);
+    bool stealBack(Slice& s, size_t& begin, size_t& end);
+    void threadMain(unsigned w);
+
+    std::vector<std::unique_ptr<Slice>> slices;
+    std::vector<std::thread> threads;
+
+    std::mutex mutex;
+    std::condition_variable wakeup;      ///< Caller -> threads: new job or shutdown
+    std::condition_variable finished;    ///< Threads -> caller: job done
+    uint64_t generation = 0;             ///< Bumped for every job
+    unsigned running = 0;                ///< Threads still inside the current job
+    bool stopping = false;
+
+    const Task* task = nullptr;          ///< Current job (valid during run())
+    size_t grain = 1;
+};
@@ -0,0 +1,37 @@
+#include "world_snapshot.h"
+
+// front/reading use sequentially consistent operations: the writer's
+// "is the reader on my back buffer?" check and the reader's "is my pinned
+// buffer still the front?" check form a Dekker-style handshake, so at least
+// one side always sees the other's store.
+
+WorldSnapshot* SnapshotExchange::beginWrite() {
+    int back = (front.load() == 0) ? 1 : 0;
+    if (reading.load() == back) {
+        skipped.fetch_add(1, std::memory_order_relaxed);
+        writing = -1;
+        return nullptr;
+    }
+    writing = back;
+    return &buffers[back];
+}
+
+void SnapshotExchange::publish() {
+    if (writing < 0) return;
+    front.store(writing);
+    writing = -1;
+}
+
+const WorldSnapshot* SnapshotExchange::acquire() {
+    while (true) {
+        int idx = front.load();
+        if (idx < 0) return nullptr;
+        reading.store(idx);
+        // If the writer published in between, it may already be filling `idx`.
+        if (front.load() == idx) return &buffers[idx];
+    }
+}
+
+void SnapshotExchange::release() {
+    reading.store(-1);
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include <netinet/in.h>
+#include "../generated/game.pb.h"
+
+/**
+ * @brief One player as captured at the end of a tick.
+ */
+struct SnapshotPlayer {
+    int id;
+    int x;
+    int y;
+    bool blocked;
+    uint32_t ack;      ///< Newest snapshot seq this player's client acknowledged (0 = none)
+    PlayerCodec codec; ///< Encoding this player's client receives
+    sockaddr_in addr;  ///< Where this player's broadcast goes
+};
+
+/**
+ * @brief Immutable view of the world published by the simulation each tick.
+ *
+ * Holds everything a broadcast needs, so encoding and sending never touch
+ * the live ClientManager tables.
+ */
+struct WorldSnapshot {
+    uint64_t sequence = 0;  ///< Increases with every publish
+    int tick = 0;
+    GameState state = GameState::UNKNOWN;
+    std::vector<SnapshotPlayer> players;
+};
+
+/**
+ * @brief Double-buffered, wait-free hand-off of WorldSnapshots between two threads.
+ *
+ * The writer (simulation thread) fills the buffer that is not published and
+ * publishes it with one atomic store. The reader (broadcast thread) pins
+ * the published buffer while it encodes. If the reader is still holding
+ * the only buffer the writer could reuse, the writer skips that publish
+ * instead of waiting, so neither side ever blocks. Buffers keep their
+ * capacity, so steady-state publishing does not allocate.
+ */
+class SnapshotExchange {
+public:
+    /**
+     * @brief Returns the buffer to fill for the next publish, or nullptr if the
+     * reader still holds it (the tick's snapshot is then skipped). Writer only.
+     */
+    WorldSnapshot* beginWrite();
+
+    /**
+     * @brief Publishes the buffer returned by beginWrite(). Writer only.
+     */
+    void publish();
+
+    /**
+     * @brief Pins and returns the latest published snapshot, or nullptr if none. Reader only.
+     *
+     * Must be paired with release().
+     */
+    const WorldSnapshot* acquire();
+
+    /**
+     * @brief Unpins the snapshot returned by acquire(). Reader only.
+     */
+    void release();
+
+    /**
+     * @brief Publishes skipped because the reader was still busy.
+     */
+    uint64_t getSkipped() const { return skipped.load(std::memory_order_relaxed); }
+
+private:
+    WorldSnapshot buffers[2];
+    std::atomic<int> front{-1};     ///< Index of the latest published buffer (-1 = none yet)
+    std::atomic<int> reading{-1};   ///< Index pinned by the reader (-1 = none)
+    int writing = -1;               ///< Index being filled by the writer
+    std::atomic<uint64_t> skipped{0};
+};
@@ -13,27 +13,29 @@ _sym_db = _symbol_database.Default()
 
 
 
-DESCRIPTOR = _descriptor_pool.Default().AddSerializedFile(b'\n\ngame.proto\";\n\x06Player\x12\n\n\x02id\x18\x01 \x01(\x05\x12\t\n\x01x\x18\x02 \x01(\x05\x12\t\n\x01y\x18\x03 \x01(\x05\x12\x0f\n\x07\x62locked\x18\x04 \x01(\x08\"\x07\n\x05Hello\"\x12\n\x04Ping\x12\n\n\x02id\x18\x01 \x01(\x05\"0\n\x0c\x43lientUpdate\x12\n\n\x02id\x18\x01 \x01(\x05\x12\t\n\x01x\x18\x02 \x01(\x05\x12\t\n\x01y\x18\x03 \x01(\x05\"\x15\n\x07Welcome\x12\n\n\x02id\x18\x01 \x01(\x05\"P\n\x0bStatePacket\x12\x19\n\x05state\x18\x01 \x01(\x0e\x32\n.GameState\x12\x0c\n\x04tick\x18\x02 \x01(\x05\x12\x18\n\x07players\x18\x03 \x03(\x0b\x32\x07.Player\"\xae\x01\n\x06Packet\x12\x17\n\x05hello\x18\x01 \x01(\x0b\x32\x06.HelloH\x00\x12\x15\n\x04ping\x18\x02 \x01(\x0b\x32\x05.PingH\x00\x12&\n\rclient_update\x18\x03 \x01(\x0b\x32\r.ClientUpdateH\x00\x12\x1b\n\x07welcome\x18\x04 \x01(\x0b\x32\x08.WelcomeH\x00\x12$\n\x0cstate_packet\x18\x05 \x01(\x0b\x32\x0c.StatePacketH\x00\x42\t\n\x07payload*=\n\tGameState\x12\x0b\n\x07UNKNOWN\x10\x00\x12\x0b\n\x07WAITING\x10\x01\x12\x0b\n\x07STARTED\x10\x02\x12\t\n\x05\x45NDED\x10\x03\x62\x06proto3')
+DESCRIPTOR = _descriptor_pool.Default().AddSerializedFile(b'\n\ngame.proto\";\n\x06Player\x12\n\n\x02id\x18\x01 \x01(\x05\x12\t\n\x01x\x18\x02 \x01(\x05\x12\t\n\x01y\x18\x03 \x01(\x05\x12\x0f\n\x07\x62locked\x18\x04 \x01(\x08\"$\n\x05Hello\x12\x1b\n\x05\x63odec\x18\x01 \x01(\x0e\x32\x0c.PlayerCodec\"#\n\x04Ping\x12\n\n\x02id\x18\x01 \x01(\x05\x12\x0f\n\x07\x61\x63k_seq\x18\x02 \x01(\r\"A\n\x0c\x43lientUpdate\x12\n\n\x02id\x18\x01 \x01(\x05\x12\t\n\x01x\x18\x02 \x01(\x05\x12\t\n\x01y\x18\x03 \x01(\x05\x12\x0f\n\x07\x61\x63k_seq\x18\x04 \x01(\r\"2\n\x07Welcome\x12\n\n\x02id\x18\x01 \x01(\x05\x12\x1b\n\x05\x63odec\x18\x02 \x01(\x0e\x32\x0c.PlayerCodec\"\xbe\x01\n\x0bStatePacket\x12\x19\n\x05state\x18\x01 \x01(\x0e\x32\n.GameState\x12\x0c\n\x04tick\x18\x02 \x01(\x05\x12\x18\n\x07players\x18\x03 \x03(\x0b\x32\x07.Player\x12\x0b\n\x03seq\x18\x04 \x01(\r\x12\x14\n\x0c\x62\x61seline_seq\x18\x05 \x01(\r\x12\x0f\n\x07removed\x18\x06 \x03(\x05\x12\x0c\n\x04part\x18\x07 \x01(\r\x12\x12\n\npart_count\x18\x08 \x01(\r\x12\x16\n\x0epacked_players\x18\t \x01(\x0c\"\xae\x01\n\x06Packet\x12\x17\n\x05hello\x18\x01 \x01(\x0b\x32\x06.HelloH\x00\x12\x15\n\x04ping\x18\x02 \x01(\x0b\x32\x05.PingH\x00\x12&\n\rclient_update\x18\x03 \x01(\x0b\x32\r.ClientUpdateH\x00\x12\x1b\n\x07welcome\x18\x04 \x01(\x0b\x32\x08.WelcomeH\x00\x12$\n\x0cstate_packet\x18\x05 \x01(\x0b\x32\x0c.StatePacketH\x00\x42\t\n\x07payload*=\n\tGameState\x12\x0b\n\x07UNKNOWN\x10\x00\x12\x0b\n\x07WAITING\x10\x01\x12\x0b\n\x07STARTED\x10\x02\x12\t\n\x05\x45NDED\x10\x03*A\n\x0bPlayerCodec\x12\x19\n\x15PLAYER_CODEC_PROTOBUF\x10\x00\x12\x17\n\x13PLAYER_CODEC_PACKED\x10\x01\x62\x06proto3')
 
 _builder.BuildMessageAndEnumDescriptors(DESCRIPTOR, globals())
 _builder.BuildTopDescriptorsAndMessages(DESCRIPTOR, 'game_pb2', globals())
 if _descriptor._USE_C_DESCRIPTORS == False:
 
   DESCRIPTOR._options = None
-  _GAMESTATE._serialized_start=436
-  _GAMESTATE._serialized_end=497
+  _GAMESTATE._serialized_start=639
+  _GAMESTATE._serialized_end=700
+  _PLAYERCODEC._serialized_start=702
+  _PLAYERCODEC._serialized_end=767
   _PLAYER._serialized_start=14
   _PLAYER._serialized_end=73
   _HELLO._serialized_start=75
-  _HELLO._serialized_end=82
-  _PING._serialized_start=84
-  _PING._serialized_end=102
-  _CLIENTUPDATE._serialized_start=104
-  _CLIENTUPDATE._serialized_end=152
-  _WELCOME._serialized_start=154
-  _WELCOME._serialized_end=175
-  _STATEPACKET._serialized_start=177
-  _STATEPACKET._serialized_end=257
-  _PACKET._serialized_start=260
-  _PACKET._serialized_end=434
+  _HELLO._serialized_end=111
+  _PING._serialized_start=113
+  _PING._serialized_end=148
+  _CLIENTUPDATE._serialized_start=150
+  _CLIENTUPDATE._serialized_end=215
+  _WELCOME._serialized_start=217
+  _WELCOME._serialized_end=267
+  _STATEPACKET._serialized_start=270
+  _STATEPACKET._serialized_end=460
+  _PACKET._serialized_start=463
+  _PACKET._serialized_end=637
 # @@protoc_insertion_point(module_scope)
@@ -20,6 +20,9 @@ lock = threading.Lock()
 max_x_seen = 1
 max_y_seen = 1
 
+# Snapshot being assembled: (seq, parts received, ids seen)
+assembling = (0, set(), set())
+
 interp_t = 0.0
 interp_speed = 0.1  # Controls smoothness
 
@@ -27,16 +30,22 @@ def lerp(a, b, t):
     return a + (b - a) * t
 
 def udp_listener():
-    global max_x_seen, max_y_seen, interp_t
+    global max_x_seen, max_y_seen, interp_t, assembling
     sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
     sock.bind(("0.0.0.0", UDP_PORT))
     while True:
         data, _ = sock.recvfrom(4096)
         pkt = game_pb2.Packet()
         if pkt.ParseFromString(data) and pkt.HasField("state_packet"):
+            sp = pkt.state_packet
             with lock:
-                current_ids = set()
-                for p in pkt.state_packet.players:
+                seq, parts_seen, current_ids = assembling
+                if sp.seq != seq:
+                    # New snapshot; parts of an unfinished one are simply superseded.
+                    seq, parts_seen, current_ids = sp.seq, set(), set()
+                    assembling = (seq, parts_seen, current_ids)
+                parts_seen.add(sp.part)
+                for p in sp.players:
                     current_ids.add(p.id)
                     if p.id in players:
                         _, _, old_x, old_y = players[p.id]
@@ -46,10 +55,11 @@ def udp_listener():
                     max_x_seen = max(max_x_seen, p.x)
                     max_y_seen = max(max_y_seen, p.y)
 
-                # 🔥 Remove players not in current packet
-                stale_ids = set(players.keys()) - current_ids
-                for pid in stale_ids:
-                    del players[pid]
+                # 🔥 Remove players not in the snapshot, once all its parts are in
+                if len(parts_seen) >= max(sp.part_count, 1):
+                    stale_ids = set(players.keys()) - current_ids
+                    for pid in stale_ids:
+                        del players[pid]
 
                 interp_t = 0.0  # reset interpolation progress
 